@@ -0,0 +1,320 @@
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include "model/Piece.h"
+#include "model/SyntheticPieceGenerator.h"
+#include "model/PieceFile.h"
+#include "services/GenerationService.h"
+
+/**
+ * @brief Benchmark headless du pipeline de génération (sans GUI ni plugin).
+ *
+ * Usage:
+ *   ./DiatonyBenchmark <dossier|fichier.diatony>... [--runs N] [--format csv|json]
+ *                      [--portfolio N] [--time-limit ms] [--output fichier]
+ *   ./DiatonyBenchmark --synthetic 10,100,1000 [--seed N] [--dump dossier] [...]
+ *
+ * Chaque pièce est résolue N fois, cache et re-résolution incrémentale désactivés,
+ * puis une ligne de résultats est produite par pièce (percentiles de latence, nœuds, mémoire).
+ */
+namespace
+{
+    struct BenchmarkOptions
+    {
+        juce::Array<juce::File> inputs;
+        int runs = 5;
+        bool json = false;
+        int portfolioSize = GenerationService::getDefaultPortfolioSize();
+        int timeLimitMs = 60000;
+        juce::File output;
+        
+        juce::Array<int> syntheticSizes;    // Pièces générées (nombre d'accords)
+        juce::int64 seed = 1;
+        juce::File dumpFolder;              // Export .diatony des pièces générées
+    };
+
+    struct PieceReport
+    {
+        juce::String name;
+        int chords = 0;
+        int sections = 0;
+        int solved = 0;
+        int runs = 0;
+        double p50Ms = 0.0;
+        double p90Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+        juce::int64 meanNodes = 0;
+        juce::int64 meanFails = 0;
+        juce::int64 peakMemoryBytes = 0;
+        juce::String error;
+    };
+
+    void printUsage()
+    {
+        std::cerr << "Usage: DiatonyBenchmark <dir|file.diatony>... [--runs N] [--format csv|json]"
+                  << " [--portfolio N] [--time-limit ms] [--output file]" << std::endl
+                  << "       DiatonyBenchmark --synthetic 10,100,1000 [--seed N] [--dump dir] [...]" << std::endl;
+    }
+
+    bool parseArguments(int argc, char* argv[], BenchmarkOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const juce::String arg = juce::String::fromUTF8(argv[i]);
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--runs" && hasValue)
+                options.runs = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+            else if (arg == "--format" && hasValue)
+                options.json = juce::String(argv[++i]).equalsIgnoreCase("json");
+            else if (arg == "--portfolio" && hasValue)
+                options.portfolioSize = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+            else if (arg == "--time-limit" && hasValue)
+                options.timeLimitMs = juce::jmax(0, juce::String(argv[++i]).getIntValue());
+            else if (arg == "--output" && hasValue)
+                options.output = juce::File::getCurrentWorkingDirectory().getChildFile(juce::String::fromUTF8(argv[++i]));
+            else if (arg == "--synthetic" && hasValue)
+            {
+                for (const auto& size : juce::StringArray::fromTokens(juce::String(argv[++i]), ",", {}))
+                    if (size.getIntValue() > 0)
+                        options.syntheticSizes.add(size.getIntValue());
+            }
+            else if (arg == "--seed" && hasValue)
+                options.seed = juce::String(argv[++i]).getLargeIntValue();
+            else if (arg == "--dump" && hasValue)
+                options.dumpFolder = juce::File::getCurrentWorkingDirectory().getChildFile(juce::String::fromUTF8(argv[++i]));
+            else if (arg.startsWith("--"))
+                return false;
+            else
+                options.inputs.add(juce::File::getCurrentWorkingDirectory().getChildFile(arg));
+        }
+
+        return !options.inputs.isEmpty() || !options.syntheticSizes.isEmpty();
+    }
+
+    /** @brief Dossiers parcourus récursivement, triés pour un ordre de sortie stable. */
+    juce::Array<juce::File> collectCorpus(const juce::Array<juce::File>& inputs)
+    {
+        juce::Array<juce::File> corpus;
+
+        for (const auto& input : inputs)
+        {
+            if (input.isDirectory())
+            {
+                auto found = input.findChildFiles(juce::File::findFiles, true, "*.diatony");
+                found.sort();
+                corpus.addArray(found);
+            }
+            else if (input.existsAsFile())
+            {
+                corpus.add(input);
+            }
+        }
+
+        return corpus;
+    }
+
+    /** @brief Même lecture que AppController::loadProjectFromFile, sans contrôleur. */
+    bool loadPiece(const juce::File& file, Piece& piece)
+    {
+        juce::ValueTree state = PieceFile::read(file);
+        if (!state.isValid())
+            return false;
+
+        piece.getState().copyPropertiesAndChildrenFrom(state, nullptr);
+        piece.restoreIdCounters();
+        return true;
+    }
+
+    /** @brief Percentile par rang le plus proche sur un échantillon trié. */
+    double percentile(const std::vector<double>& sorted, double fraction)
+    {
+        if (sorted.empty())
+            return 0.0;
+
+        const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+        return sorted[juce::jlimit<size_t>(0, sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+    }
+
+    PieceReport benchmarkPiece(GenerationService& service, const juce::String& name, const Piece& piece,
+                               const BenchmarkOptions& options, const juce::File& scratchMidi)
+    {
+        PieceReport report;
+        report.name = name;
+        report.chords = piece.getTotalChordCount();
+        report.sections = static_cast<int>(piece.getSectionCount());
+
+        GenerationBudget budget;
+        budget.timeLimitMs = options.timeLimitMs;
+
+        std::vector<double> latencies;
+        juce::int64 totalNodes = 0;
+        juce::int64 totalFails = 0;
+
+        for (int run = 0; run < options.runs; ++run)
+        {
+            auto result = service.generateNow(piece, scratchMidi.getFullPathName(), budget);
+            ++report.runs;
+
+            if (!result.success)
+            {
+                report.error = result.error;
+                continue;
+            }
+
+            ++report.solved;
+            latencies.push_back(result.stats.totalMs);
+            totalNodes += result.stats.nodes;
+            totalFails += result.stats.fails;
+            report.peakMemoryBytes = juce::jmax(report.peakMemoryBytes, result.stats.peakMemoryBytes);
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        report.p50Ms = percentile(latencies, 0.50);
+        report.p90Ms = percentile(latencies, 0.90);
+        report.p99Ms = percentile(latencies, 0.99);
+        report.maxMs = latencies.empty() ? 0.0 : latencies.back();
+
+        if (report.solved > 0)
+        {
+            report.meanNodes = totalNodes / report.solved;
+            report.meanFails = totalFails / report.solved;
+        }
+
+        return report;
+    }
+
+    juce::String toCsv(const std::vector<PieceReport>& reports)
+    {
+        juce::String csv = "piece,sections,chords,runs,solved,p50_ms,p90_ms,p99_ms,max_ms,nodes,fails,peak_rss_bytes,error\n";
+
+        for (const auto& r : reports)
+        {
+            juce::StringArray fields;
+            fields.add(r.name.quoted());
+            fields.add(juce::String(r.sections));
+            fields.add(juce::String(r.chords));
+            fields.add(juce::String(r.runs));
+            fields.add(juce::String(r.solved));
+            fields.add(juce::String(r.p50Ms, 3));
+            fields.add(juce::String(r.p90Ms, 3));
+            fields.add(juce::String(r.p99Ms, 3));
+            fields.add(juce::String(r.maxMs, 3));
+            fields.add(juce::String(r.meanNodes));
+            fields.add(juce::String(r.meanFails));
+            fields.add(juce::String(r.peakMemoryBytes));
+            fields.add(r.error.replace("\"", "'").quoted());
+            csv << fields.joinIntoString(",") << "\n";
+        }
+
+        return csv;
+    }
+
+    juce::String toJson(const std::vector<PieceReport>& reports)
+    {
+        juce::Array<juce::var> pieces;
+
+        for (const auto& r : reports)
+        {
+            auto* entry = new juce::DynamicObject();
+            entry->setProperty("piece", r.name);
+            entry->setProperty("sections", r.sections);
+            entry->setProperty("chords", r.chords);
+            entry->setProperty("runs", r.runs);
+            entry->setProperty("solved", r.solved);
+            entry->setProperty("p50Ms", r.p50Ms);
+            entry->setProperty("p90Ms", r.p90Ms);
+            entry->setProperty("p99Ms", r.p99Ms);
+            entry->setProperty("maxMs", r.maxMs);
+            entry->setProperty("nodes", r.meanNodes);
+            entry->setProperty("fails", r.meanFails);
+            entry->setProperty("peakRssBytes", r.peakMemoryBytes);
+            entry->setProperty("error", r.error);
+            pieces.add(juce::var(entry));
+        }
+
+        return juce::JSON::toString(juce::var(pieces));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    if (!parseArguments(argc, argv, options))
+    {
+        printUsage();
+        return 2;
+    }
+
+    const auto corpus = collectCorpus(options.inputs);
+    if (corpus.isEmpty() && options.syntheticSizes.isEmpty())
+    {
+        std::cerr << "No .diatony file found" << std::endl;
+        return 2;
+    }
+
+    GenerationService service;
+    service.setCacheEnabled(false);
+    service.setIncrementalEnabled(false);
+    service.setEnumerationCount(1);
+    service.setPortfolioSize(options.portfolioSize);
+
+    juce::TemporaryFile scratchMidi(".mid");
+    std::vector<PieceReport> reports;
+    int failures = 0;
+
+    auto addReport = [&](PieceReport report)
+    {
+        if (report.solved < report.runs || report.runs == 0)
+            ++failures;
+
+        std::cerr << report.name << ": " << report.solved << "/" << report.runs
+                  << " solved, p50 " << report.p50Ms << " ms" << std::endl;
+        reports.push_back(std::move(report));
+    };
+
+    for (const auto& file : corpus)
+    {
+        Piece piece;
+        if (!loadPiece(file, piece))
+        {
+            PieceReport unreadable;
+            unreadable.name = file.getFileName();
+            unreadable.error = "unreadable file";
+            addReport(unreadable);
+            continue;
+        }
+
+        addReport(benchmarkPiece(service, file.getFileName(), piece, options, scratchMidi.getFile()));
+    }
+
+    for (int size : options.syntheticSizes)
+    {
+        SyntheticPieceGenerator::Options generatorOptions;
+        generatorOptions.totalChords = size;
+        generatorOptions.seed = options.seed;
+
+        Piece piece;
+        SyntheticPieceGenerator::generate(piece, generatorOptions);
+
+        const juce::String name = "synthetic_" + juce::String(size) + "_seed" + juce::String(options.seed) + ".diatony";
+        if (options.dumpFolder != juce::File()
+            && options.dumpFolder.createDirectory()
+            && !SyntheticPieceGenerator::writeToFile(piece, options.dumpFolder.getChildFile(name)))
+            std::cerr << "Could not write " << name << std::endl;
+
+        addReport(benchmarkPiece(service, name, piece, options, scratchMidi.getFile()));
+    }
+
+    const juce::String text = options.json ? toJson(reports) : toCsv(reports);
+
+    if (options.output != juce::File())
+        options.output.replaceWithText(text);
+    else
+        std::cout << text << std::endl;
+
+    return failures > 0 ? 1 : 0;
+}
@@ -160,8 +160,13 @@ void AppController::startGeneration()
     
     selectionState.setProperty("generationStatus", "generating", nullptr);
     
+    lastRequestedState = piece.getState().createCopy();
+    solutionMidiPaths.clear();
+    lastEnumerationStats = GenerationStats();
+    selectionState.setProperty("solutionCount", 0, nullptr);
+    
     juce::String dummyPath = "";
-    bool launched = generationService.startGeneration(piece, dummyPath, this);
+    bool launched = generationService.startGeneration(piece, dummyPath, this, generationBudget);
     
     if (!launched)
     {
@@ -172,6 +177,12 @@ void AppController::startGeneration()
     }
 }
 
+void AppController::cancelGeneration()
+{
+    if (generationService.isGenerating())
+        generationService.cancelGeneration();
+}
+
 bool AppController::loadProjectFromFile(const juce::File& file)
 {
     if (!file.existsAsFile())
@@ -180,51 +191,136 @@ bool AppController::loadProjectFromFile(const juce::File& file)
     if (!file.hasFileExtension(".diatony") && !file.hasFileExtension(".xml"))
         return false;
     
-    auto xml = juce::XmlDocument::parse(file);
-    if (xml == nullptr)
-        return false;
-    
-    if (xml->getTagName() != "Piece")
-        return false;
-    
-    juce::ValueTree newState = juce::ValueTree::fromXml(*xml);
+    // Statistiques de génération : métadonnées du fichier, écartées de la pièce par PieceFile
+    juce::ValueTree newState = PieceFile::read(file);
     if (!newState.isValid())
         return false;
     
-    // nullptr : pas d'undo pour le chargement complet
-    piece.getState().copyPropertiesAndChildrenFrom(newState, nullptr);
+    // nullptr : pas d'undo pour le chargement complet ; un seul lot pour une seule resynchronisation UI
+    performEditBatch("Load project", [&newState](Piece& loaded) {
+        loaded.getState().copyPropertiesAndChildrenFrom(newState, nullptr);
+        loaded.restoreIdCounters();
+    });
     clearSelection();
     
     return true;
 }
 
+bool AppController::exportProjectToXml(const juce::File& file) const
+{
+    return PieceFile::writeXml(piece.getState(), file);
+}
+
+void AppController::setEnumerationCount(int numSolutions)
+{
+    generationService.setEnumerationCount(numSolutions);
+}
+
+void AppController::selectSolution(int index)
+{
+    if (index < 0 || index >= solutionMidiPaths.size())
+        return;
+    
+    selectionState.setProperty("solutionIndex", index + 1, nullptr);
+    selectionState.setProperty("midiFilePath", solutionMidiPaths[index], nullptr);
+}
+
+void AppController::drainStreamedSolutions()
+{
+    const int latestJobId = generationService.getLatestJobId();
+    StreamedSolution solution;
+    
+    while (generationService.popStreamedSolution(solution))
+    {
+        if (solution.jobId != latestJobId)
+            continue;
+        
+        if (solution.midiPath.isNotEmpty() && !solutionMidiPaths.contains(solution.midiPath))
+            solutionMidiPaths.add(solution.midiPath);
+        
+        // Statistiques mises à jour par le worker avant chaque push : finales avec la dernière solution
+        if (solution.isLast)
+            lastEnumerationStats = generationService.getLastResult().enumerationStats;
+        
+        selectionState.setProperty("solutionTotal", solution.isLast ? solutionMidiPaths.size()
+                                                                    : solution.requestedCount, nullptr);
+        selectionState.setProperty("solutionCount", solutionMidiPaths.size(), nullptr);
+    }
+}
+
 void AppController::handleAsyncUpdate()
 {
-    bool success = generationService.getLastGenerationSuccess();
+    drainStreamedSolutions();
+    
+    auto result = generationService.getLastResult();
+    
+    // Une requête plus récente a été mise en file depuis : son résultat arrivera plus tard
+    if (result.jobId != generationService.getLatestJobId())
+        return;
+    
+    // Les solutions streamées rappellent ce callback : le résultat principal n'est traité qu'une fois
+    if (result.jobId == lastHandledJobId)
+        return;
     
-    if (success)
+    lastHandledJobId = result.jobId;
+    
+    if (result.success)
     {
-        juce::String midiPath = generationService.getLastGeneratedMidiPath();
+        juce::String midiPath = result.midiPath;
         if (midiPath.isNotEmpty())
         {
             juce::File midiFile(midiPath);
             juce::File diatonyFile = midiFile.withFileExtension("diatony");
-            juce::String xmlContent = piece.getState().toXmlString();
-            diatonyFile.replaceWithText(xmlContent);
+            // La pièce a pu être éditée pendant la résolution : on sauvegarde celle qui a été résolue
+            const double writeStartMs = juce::Time::getMillisecondCounterHiRes();
+            juce::ValueTree metadata(PieceFile::metadataType);
+            if (auto statsXml = result.stats.createXml())
+            {
+                // Mesurée après l'écriture : elle ne peut pas figurer dans le fichier qu'elle chronomètre
+                statsXml->removeAttribute("sidecarWriteMs");
+                metadata.appendChild(juce::ValueTree::fromXml(*statsXml), nullptr);
+            }
+            PieceFile::write(lastRequestedState, diatonyFile, metadata);
+            result.stats.sidecarWriteMs = juce::Time::getMillisecondCounterHiRes() - writeStartMs;
         }
         
+        lastGenerationStats = result.stats;
+        
+        // Durée complète de la requête : timeToFirstSolutionMs vaut 0 quand aucune recherche n'a eu lieu
+        selectionState.setProperty("generationTimeMs", result.stats.totalMs, nullptr);
+        selectionState.setProperty("generationSource", result.fromCache ? "cache"
+                                                       : result.pinnedChords > 0 ? "incremental" : "solver", nullptr);
+        selectionState.setProperty("pinnedChords", result.pinnedChords, nullptr);
+        selectionState.setProperty("solutionIndex", 1, nullptr);
+        
+        // Mode anytime : coût final (trajectoire complète dans GenerationResult)
+        juce::StringArray finalCost;
+        if (result.optimised && !result.costTrajectory.empty())
+            for (int value : result.costTrajectory.back().cost)
+                finalCost.add(juce::String(value));
+        selectionState.setProperty("solutionCost", finalCost.joinIntoString(","), nullptr);
         selectionState.setProperty("generationStatus", "completed", nullptr);
         selectionState.setProperty("midiFilePath", midiPath, nullptr);
     }
+    else if (result.cancelled)
+    {
+        selectionState.setProperty("generationStatus", "cancelled", nullptr);
+    }
     else
     {
         // Définir le message AVANT le status (le listener lit le message quand le status change)
-        selectionState.setProperty("generationError", generationService.getLastError(), nullptr);
-        juce::String status = generationService.isInputValidationError() ? "warning" : "error";
+        selectionState.setProperty("generationError", result.error, nullptr);
+        juce::String status = result.inputValidationError ? "warning" : "error";
         selectionState.setProperty("generationStatus", status, nullptr);
     }
 }
 
+void AppController::performEditBatch(const juce::String& transactionName, const std::function<void(Piece&)>& edits)
+{
+    Piece::ScopedEditBatch batch(piece, transactionName);
+    edits(piece);
+}
+
 void AppController::undo()
 {
     if (canUndo())
@@ -2,8 +2,10 @@
 
 #include <juce_core/juce_core.h>
 #include <juce_data_structures/juce_data_structures.h>
+#include <functional>
 #include "../model/Piece.h"
 #include "../model/ModelIdentifiers.h"
+#include "../model/PieceFile.h"
 #include "ContextIdentifiers.h"
 #include "../services/GenerationService.h"
 
@@ -41,9 +43,42 @@ public:
     void setPieceTitle(const juce::String& title);
     void startGeneration();
     
-    /** @brief Charge un projet depuis un fichier .diatony (XML). */
+    /** @brief Annule la génération en cours ; le statut passe à "cancelled" au retour du solveur. */
+    void cancelGeneration();
+    
+    /** @brief Budget des prochaines générations (temps/nœuds, échéance du mode anytime). */
+    void setGenerationBudget(const GenerationBudget& budget) { generationBudget = budget; }
+    const GenerationBudget& getGenerationBudget() const { return generationBudget; }
+    
+    /** @brief Nombre de solutions alternatives à énumérer par génération (1 = solution unique). */
+    void setEnumerationCount(int numSolutions);
+    int getEnumerationCount() const { return generationService.getEnumerationCount(); }
+    
+    /** @brief Rend la solution index (0-based) courante : midiFilePath pointe sur son fichier. */
+    void selectSolution(int index);
+    const juce::StringArray& getSolutionMidiPaths() const { return solutionMidiPaths; }
+    
+    /** @brief Statistiques de la dernière génération réussie (sidecarWriteMs inclus, absent du .diatony). */
+    const GenerationStats& getLastGenerationStats() const { return lastGenerationStats; }
+    
+    /** @brief Recherche des alternatives de la dernière génération (reçue avec la dernière solution streamée). */
+    const GenerationStats& getLastEnumerationStats() const { return lastEnumerationStats; }
+    
+    /** @brief Charge un projet depuis un fichier .diatony (binaire, ou XML pour l'import). */
     bool loadProjectFromFile(const juce::File& file);
     
+    /** @brief Exporte la pièce courante en XML (format lisible, réimportable). */
+    bool exportProjectToXml(const juce::File& file) const;
+    
+    /**
+     * @brief Applique edits(piece) comme un seul lot : une transaction d'undo, une notification
+     * pieceEditBatchEnded en fin de lot (au lieu d'une resynchronisation UI par édition).
+     */
+    void performEditBatch(const juce::String& transactionName, const std::function<void(Piece&)>& edits);
+    bool isInEditBatch() const { return piece.isInEditBatch(); }
+    void addEditBatchListener(Piece::Listener* listener) { piece.addListener(listener); }
+    void removeEditBatchListener(Piece::Listener* listener) { piece.removeListener(listener); }
+    
     void undo();
     void redo();
     bool canUndo() const;
@@ -67,6 +102,15 @@ private:
     EditMode currentEditMode;
     juce::ValueTree selectionState;
     GenerationService generationService;
+    juce::ValueTree lastRequestedState;  // Copie de la pièce telle que soumise, pour le .diatony associé au MIDI
+    GenerationBudget generationBudget;
+    int lastHandledJobId = 0;            // handleAsyncUpdate est rappelé à chaque solution streamée
+    juce::StringArray solutionMidiPaths; // Solutions énumérées de la dernière génération (ordre d'arrivée)
+    GenerationStats lastGenerationStats;
+    GenerationStats lastEnumerationStats;
+    
+    /** @brief Consomme les solutions streamées par le service et met à jour "solution i of K". */
+    void drainStreamedSolutions();
     
     void setEditMode(EditMode newMode);
     void updateSelectionFromIndices(int sectionIndex, int chordIndex = -1);
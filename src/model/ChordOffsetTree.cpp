@@ -0,0 +1,93 @@
+#include "ChordOffsetTree.h"
+
+namespace
+{
+    inline int lowestBit(int i) { return i & -i; }
+}
+
+void ChordOffsetTree::build(const std::vector<int>& chordCounts)
+{
+    counts = chordCounts;
+    tree.assign(counts.size() + 1, 0);
+
+    // Construction linéaire : chaque nœud propage sa somme à son parent direct
+    for (size_t i = 1; i < tree.size(); ++i)
+    {
+        tree[i] += counts[i - 1];
+        const size_t parent = i + static_cast<size_t>(lowestBit(static_cast<int>(i)));
+        if (parent < tree.size())
+            tree[parent] += tree[i];
+    }
+}
+
+void ChordOffsetTree::pushBack(int chordCount)
+{
+    const int position = getNumSections() + 1;
+
+    // Le nouveau nœud couvre (position - lowestBit, position] : somme des sections déjà présentes + la nouvelle
+    const int covered = getOffset(position - 1) - getOffset(position - lowestBit(position));
+    counts.push_back(chordCount);
+    tree.push_back(covered + chordCount);
+}
+
+void ChordOffsetTree::popBack()
+{
+    if (counts.empty())
+        return;
+
+    // Aucun autre nœud ne couvre la dernière position
+    counts.pop_back();
+    tree.pop_back();
+}
+
+void ChordOffsetTree::clear()
+{
+    counts.clear();
+    tree.assign(1, 0);
+}
+
+void ChordOffsetTree::add(int sectionIndex, int delta)
+{
+    if (sectionIndex < 0 || sectionIndex >= getNumSections())
+        return;
+
+    counts[static_cast<size_t>(sectionIndex)] += delta;
+
+    for (int i = sectionIndex + 1; i <= getNumSections(); i += lowestBit(i))
+        tree[static_cast<size_t>(i)] += delta;
+}
+
+int ChordOffsetTree::getOffset(int sectionIndex) const
+{
+    int sum = 0;
+    for (int i = sectionIndex < getNumSections() ? sectionIndex : getNumSections(); i > 0; i -= lowestBit(i))
+        sum += tree[static_cast<size_t>(i)];
+    return sum;
+}
+
+int ChordOffsetTree::findSection(int globalChordIndex) const
+{
+    if (globalChordIndex < 0 || globalChordIndex >= getTotal())
+        return -1;
+
+    const int n = getNumSections();
+    int step = 1;
+    while (step * 2 <= n)
+        step *= 2;
+
+    // Descente binaire : plus grande position dont le préfixe reste <= globalChordIndex
+    int position = 0;
+    int remaining = globalChordIndex;
+
+    for (; step > 0; step /= 2)
+    {
+        const int next = position + step;
+        if (next <= n && tree[static_cast<size_t>(next)] <= remaining)
+        {
+            position = next;
+            remaining -= tree[static_cast<size_t>(next)];
+        }
+    }
+
+    return position;
+}
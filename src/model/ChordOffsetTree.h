@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Arbre de Fenwick sur le nombre d'accords par section.
+ *
+ * Décalage global d'une section et section contenant un accord global en O(log n),
+ * mise à jour d'un compte (ajout/retrait d'accord) en O(log n), ajout/retrait en fin en O(log n).
+ */
+class ChordOffsetTree
+{
+public:
+    /** @brief Reconstruit l'arbre depuis les comptes par section, en O(n). */
+    void build(const std::vector<int>& chordCounts);
+
+    void pushBack(int chordCount);
+    void popBack();
+    void clear();
+
+    /** @brief Ajoute delta au compte de la section (+1 / -1 pour un accord). */
+    void add(int sectionIndex, int delta);
+
+    int getNumSections() const { return static_cast<int>(counts.size()); }
+    int getCount(int sectionIndex) const { return counts[static_cast<size_t>(sectionIndex)]; }
+
+    /** @brief Somme des comptes des sections [0, sectionIndex) : indice global du premier accord. */
+    int getOffset(int sectionIndex) const;
+    int getTotal() const { return getOffset(getNumSections()); }
+
+    /** @brief Section contenant l'accord global (-1 hors bornes) ; les sections vides sont sautées. */
+    int findSection(int globalChordIndex) const;
+
+private:
+    std::vector<int> tree { 0 };    // Indexé à partir de 1
+    std::vector<int> counts;
+};
@@ -33,4 +33,9 @@ namespace ModelIdentifiers
     const juce::Identifier toSectionId    { "toSectionId" };
     const juce::Identifier fromChordIndex { "fromChordIndex" };
     const juce::Identifier toChordIndex   { "toChordIndex" };
+    
+    // Compteurs d'IDs monotones (Piece : sections/modulations, Progression : accords)
+    const juce::Identifier nextSectionId    { "nextSectionId" };
+    const juce::Identifier nextModulationId { "nextModulationId" };
+    const juce::Identifier nextChordId      { "nextChordId" };
 } 
\ No newline at end of file
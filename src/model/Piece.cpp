@@ -14,6 +14,24 @@ Piece::Piece(const juce::String& pieceTitle)
     state.setProperty(ModelIdentifiers::name, pieceTitle, nullptr);
 }
 
+Piece::ScopedEditBatch::ScopedEditBatch(Piece& pieceToEdit, const juce::String& transactionName)
+    : piece(pieceToEdit)
+{
+    if (piece.editBatchDepth++ == 0)
+        piece.undoManager.beginNewTransaction(transactionName);
+}
+
+Piece::ScopedEditBatch::~ScopedEditBatch()
+{
+    jassert(piece.editBatchDepth > 0);
+    if (--piece.editBatchDepth > 0)
+        return;
+    
+    // Ferme la transaction : les éditions suivantes ne s'y ajoutent pas
+    piece.undoManager.beginNewTransaction();
+    piece.listeners.call([this](Listener& l) { l.pieceEditBatchEnded(piece); });
+}
+
 void Piece::addSection(const juce::String& sectionName)
 {
     auto sectionNode = createSectionNode(sectionName);
@@ -100,81 +118,73 @@ void Piece::removeLastSection()
 void Piece::clear()
 {
     state.removeAllChildren(&undoManager);
+    state.setProperty(ModelIdentifiers::nextSectionId, 0, &undoManager);
+    state.setProperty(ModelIdentifiers::nextModulationId, 0, &undoManager);
     assertInvariants();
 }
 
-Section Piece::getSection(size_t index) const { return Section(getChildOfType(ModelIdentifiers::SECTION, index)); }
-Modulation Piece::getModulation(size_t index) const { return Modulation(getChildOfType(ModelIdentifiers::MODULATION, index)); }
+Section Piece::getSection(size_t sectionIndex) const
+{
+    auto node = index.getSection(static_cast<int>(sectionIndex));
+    jassert(node.isValid());
+    return Section(node);
+}
+
+Modulation Piece::getModulation(size_t modulationIndex) const
+{
+    auto node = index.getModulation(static_cast<int>(modulationIndex));
+    jassert(node.isValid());
+    return Modulation(node);
+}
 
 Section Piece::getSectionById(int id) const
 {
-    for (int i = 0; i < state.getNumChildren(); ++i)
-    {
-        auto child = state.getChild(i);
-        if (child.hasType(ModelIdentifiers::SECTION) && static_cast<int>(child.getProperty(ModelIdentifiers::id, -1)) == id)
-            return Section(child);
-    }
+    auto node = index.getSection(index.getSectionIndexById(id));
+    if (node.isValid())
+        return Section(node);
     jassertfalse;
     return Section(juce::ValueTree(ModelIdentifiers::SECTION));
 }
 
 Modulation Piece::getModulationById(int id) const
 {
-    for (int i = 0; i < state.getNumChildren(); ++i)
-    {
-        auto child = state.getChild(i);
-        if (child.hasType(ModelIdentifiers::MODULATION) && static_cast<int>(child.getProperty(ModelIdentifiers::id, -1)) == id)
-            return Modulation(child);
-    }
+    auto node = index.getModulation(index.getModulationIndexById(id));
+    if (node.isValid())
+        return Modulation(node);
     jassertfalse;
     return Modulation(juce::ValueTree(ModelIdentifiers::MODULATION));
 }
 
-int Piece::getSectionIndexById(int id) const
-{
-    int sectionIndex = 0;
-    for (int i = 0; i < state.getNumChildren(); ++i)
-    {
-        auto child = state.getChild(i);
-        if (child.hasType(ModelIdentifiers::SECTION))
-        {
-            if (static_cast<int>(child.getProperty(ModelIdentifiers::id, -1)) == id)
-                return sectionIndex;
-            sectionIndex++;
-        }
-    }
-    return -1;
-}
+int Piece::getSectionIndexById(int id) const { return index.getSectionIndexById(id); }
+int Piece::getModulationIndexById(int id) const { return index.getModulationIndexById(id); }
+
+int Piece::getChordIndexById(int sectionId, int chordId) const { return index.getChordIndexById(sectionId, chordId); }
 
-int Piece::getModulationIndexById(int id) const
+Chord Piece::getChordById(int sectionId, int chordId) const
 {
-    int modulationIndex = 0;
-    for (int i = 0; i < state.getNumChildren(); ++i)
-    {
-        auto child = state.getChild(i);
-        if (child.hasType(ModelIdentifiers::MODULATION))
-        {
-            if (static_cast<int>(child.getProperty(ModelIdentifiers::id, -1)) == id)
-                return modulationIndex;
-            modulationIndex++;
-        }
-    }
-    return -1;
+    const int chordIndex = index.getChordIndexById(sectionId, chordId);
+    if (chordIndex < 0)
+        return Chord(juce::ValueTree());
+    
+    auto section = index.getSection(index.getSectionIndexById(sectionId));
+    return Chord(section.getChildWithName(ModelIdentifiers::PROGRESSION).getChild(chordIndex));
 }
 
 std::vector<Section> Piece::getSections() const
 {
     std::vector<Section> sections;
-    for (const auto& node : getChildrenOfType(ModelIdentifiers::SECTION))
-        sections.emplace_back(node);
+    sections.reserve(static_cast<size_t>(index.getNumSections()));
+    for (int i = 0; i < index.getNumSections(); ++i)
+        sections.emplace_back(index.getSection(i));
     return sections;
 }
 
 std::vector<Modulation> Piece::getModulations() const
 {
     std::vector<Modulation> modulations;
-    for (const auto& node : getChildrenOfType(ModelIdentifiers::MODULATION))
-        modulations.emplace_back(node);
+    modulations.reserve(static_cast<size_t>(index.getNumModulations()));
+    for (int i = 0; i < index.getNumModulations(); ++i)
+        modulations.emplace_back(index.getModulation(i));
     return modulations;
 }
 
@@ -183,8 +193,8 @@ std::pair<Section, Section> Piece::getAdjacentSections(const Modulation& modulat
     return { getSectionById(modulation.getFromSectionId()), getSectionById(modulation.getToSectionId()) };
 }
 
-size_t Piece::getSectionCount() const { return getChildrenOfType(ModelIdentifiers::SECTION).size(); }
-size_t Piece::getModulationCount() const { return getChildrenOfType(ModelIdentifiers::MODULATION).size(); }
+size_t Piece::getSectionCount() const { return static_cast<size_t>(index.getNumSections()); }
+size_t Piece::getModulationCount() const { return static_cast<size_t>(index.getNumModulations()); }
 int Piece::getNumElements() const { return state.getNumChildren(); }
 bool Piece::isEmpty() const { return state.getNumChildren() == 0; }
 void Piece::setTitle(const juce::String& newTitle) { state.setProperty(ModelIdentifiers::name, newTitle, &undoManager); }
@@ -225,12 +235,16 @@ void Piece::assertInvariants() const
 #endif
 }
 
-int Piece::getTotalChordCount() const
+int Piece::getTotalChordCount() const { return index.getTotalChordCount(); }
+int Piece::getSectionChordOffset(size_t sectionIndex) const { return index.getFirstChordIndex(static_cast<int>(sectionIndex)); }
+int Piece::getGlobalChordIndex(size_t sectionIndex, int chordIndex) const { return getSectionChordOffset(sectionIndex) + chordIndex; }
+
+std::pair<int, int> Piece::getChordLocation(int globalChordIndex) const
 {
-    int total = 0;
-    for (const auto& section : getSections())
-        total += static_cast<int>(section.getProgression().size());
-    return total;
+    const int sectionIndex = index.findSectionForChord(globalChordIndex);
+    if (sectionIndex < 0)
+        return { -1, -1 };
+    return { sectionIndex, globalChordIndex - index.getFirstChordIndex(sectionIndex) };
 }
 
 juce::String Piece::toString() const
@@ -261,28 +275,56 @@ juce::String Piece::getDetailedSummary() const
     return result;
 }
 
-int Piece::generateNextSectionId() const
+int Piece::generateNextSectionId()
+{
+    return allocateId(ModelIdentifiers::nextSectionId, ModelIdentifiers::SECTION);
+}
+
+int Piece::generateNextModulationId()
+{
+    return allocateId(ModelIdentifiers::nextModulationId, ModelIdentifiers::MODULATION);
+}
+
+int Piece::allocateId(const juce::Identifier& counter, const juce::Identifier& type)
+{
+    // Compteur absent (pièce d'un ancien fichier) : reconstruit une seule fois par balayage
+    const int nextId = state.hasProperty(counter) ? static_cast<int>(state.getProperty(counter))
+                                                  : scanNextId(state, type);
+    
+    // Même UndoManager que l'ajout : annuler la création restitue aussi le compteur
+    state.setProperty(counter, nextId + 1, &undoManager);
+    return nextId;
+}
+
+int Piece::scanNextId(const juce::ValueTree& parent, const juce::Identifier& type)
 {
     int maxId = -1;
-    for (int i = 0; i < state.getNumChildren(); ++i)
+    for (int i = 0; i < parent.getNumChildren(); ++i)
     {
-        auto child = state.getChild(i);
-        if (child.hasType(ModelIdentifiers::SECTION))
+        auto child = parent.getChild(i);
+        if (child.hasType(type))
             maxId = std::max(maxId, static_cast<int>(child.getProperty(ModelIdentifiers::id, -1)));
     }
     return maxId + 1;
 }
 
-int Piece::generateNextModulationId() const
+void Piece::restoreIdCounters()
 {
-    int maxId = -1;
-    for (int i = 0; i < state.getNumChildren(); ++i)
+    auto restore = [](juce::ValueTree& node, const juce::Identifier& counter, const juce::Identifier& type)
     {
-        auto child = state.getChild(i);
-        if (child.hasType(ModelIdentifiers::MODULATION))
-            maxId = std::max(maxId, static_cast<int>(child.getProperty(ModelIdentifiers::id, -1)));
+        const int stored = node.getProperty(counter, 0);
+        node.setProperty(counter, std::max(stored, scanNextId(node, type)), nullptr);
+    };
+    
+    restore(state, ModelIdentifiers::nextSectionId, ModelIdentifiers::SECTION);
+    restore(state, ModelIdentifiers::nextModulationId, ModelIdentifiers::MODULATION);
+    
+    for (int i = 0; i < index.getNumSections(); ++i)
+    {
+        auto progression = index.getSection(i).getChildWithName(ModelIdentifiers::PROGRESSION);
+        if (progression.isValid())
+            restore(progression, ModelIdentifiers::nextChordId, ModelIdentifiers::CHORD);
     }
-    return maxId + 1;
 }
 
 juce::ValueTree Piece::createSectionNode(const juce::String& name)
@@ -304,13 +346,14 @@ juce::ValueTree Piece::createSectionNode(const juce::String& name)
 juce::ValueTree Piece::createModulationNode(int fromSectionId, int toSectionId)
 {
     juce::ValueTree modulationNode(ModelIdentifiers::MODULATION);
-    modulationNode.setProperty(ModelIdentifiers::id, generateNextModulationId(), nullptr);
+    const int modulationId = generateNextModulationId();
+    modulationNode.setProperty(ModelIdentifiers::id, modulationId, nullptr);
     modulationNode.setProperty(ModelIdentifiers::modulationType, static_cast<int>(Diatony::ModulationType::PivotChord), nullptr);
     modulationNode.setProperty(ModelIdentifiers::fromSectionId, fromSectionId, nullptr);
     modulationNode.setProperty(ModelIdentifiers::toSectionId, toSectionId, nullptr);
     modulationNode.setProperty(ModelIdentifiers::fromChordIndex, -1, nullptr);
     modulationNode.setProperty(ModelIdentifiers::toChordIndex, -1, nullptr);
-    modulationNode.setProperty(ModelIdentifiers::name, "Modulation " + juce::String(generateNextModulationId() - 1), nullptr);
+    modulationNode.setProperty(ModelIdentifiers::name, "Modulation " + juce::String(modulationId - 1), nullptr);
     return modulationNode;
 }
 
@@ -324,26 +367,3 @@ int Piece::findValueTreeIndex(const juce::Identifier& type, int id) const
     }
     return -1;
 }
-
-std::vector<juce::ValueTree> Piece::getChildrenOfType(const juce::Identifier& type) const
-{
-    std::vector<juce::ValueTree> children;
-    for (int i = 0; i < state.getNumChildren(); ++i)
-    {
-        auto child = state.getChild(i);
-        if (child.hasType(type))
-            children.push_back(child);
-    }
-    return children;
-}
-
-juce::ValueTree Piece::getChildOfType(const juce::Identifier& type, size_t index) const
-{
-    auto children = getChildrenOfType(type);
-    if (index >= children.size())
-    {
-        jassertfalse;
-        return juce::ValueTree();
-    }
-    return children[index];
-}
@@ -5,18 +5,51 @@
 #include "Section.h"
 #include "Modulation.h"
 #include "ModelIdentifiers.h"
+#include "PieceIndex.h"
 
 /**
  * @brief Pièce musicale complète : sections tonales reliées par des modulations.
  * 
- * Propriétaire du ValueTree racine. Gère les IDs et garantit l'invariant :
+ * Propriétaire du ValueTree racine. Gère les IDs (compteurs monotones stockés dans l'arbre,
+ * donc persistés avec le .diatony) et garantit l'invariant :
  * modulations.count == sections.count - 1, avec alternance S-M-S-M-S.
+ * Accès par rang/id et nombre d'accords en O(1) via PieceIndex, tenu à jour par listener.
  */
 class Piece {
 public:
     Piece();
     explicit Piece(const juce::String& pieceTitle);
     
+    /** @brief Observateur des lots d'éditions : une seule notification à la fermeture du lot. */
+    struct Listener
+    {
+        virtual ~Listener() = default;
+        virtual void pieceEditBatchEnded(Piece& piece) = 0;
+    };
+    
+    void addListener(Listener* listener) { listeners.add(listener); }
+    void removeListener(Listener* listener) { listeners.remove(listener); }
+    
+    /**
+     * @brief Lot d'éditions RAII : toutes les modifications annulables forment une seule transaction.
+     * 
+     * Les listeners ValueTree reçoivent toujours chaque changement ; ceux qui reconstruisent beaucoup
+     * consultent isInEditBatch() pour différer, puis se resynchronisent sur pieceEditBatchEnded().
+     * Imbriquable : seul le lot le plus externe ouvre la transaction et notifie.
+     */
+    class ScopedEditBatch
+    {
+    public:
+        explicit ScopedEditBatch(Piece& pieceToEdit, const juce::String& transactionName = {});
+        ~ScopedEditBatch();
+        
+    private:
+        Piece& piece;
+        JUCE_DECLARE_NON_COPYABLE(ScopedEditBatch)
+    };
+    
+    bool isInEditBatch() const { return editBatchDepth > 0; }
+    
     /** @brief Ajoute une section (+ modulation automatique si pas la première) */
     void addSection(const juce::String& sectionName = "Section");
     
@@ -25,6 +58,14 @@ public:
     void removeLastSection();
     void clear();
     
+    /**
+     * @brief Recale les compteurs d'IDs (pièce et progressions) sur les IDs présents.
+     * 
+     * À appeler après un remplacement complet de l'arbre (chargement) : un fichier ancien
+     * n'a pas de compteurs, un fichier édité à la main peut en avoir de trop bas.
+     */
+    void restoreIdCounters();
+    
     Section getSection(size_t index) const;
     Modulation getModulation(size_t index) const;
     Section getSectionById(int id) const;
@@ -32,6 +73,10 @@ public:
     int getSectionIndexById(int id) const;
     int getModulationIndexById(int id) const;
     
+    /** @brief Rang / accord d'ID donné dans la section d'ID donné, via table de hachage (-1 / invalide si inconnu). */
+    int getChordIndexById(int sectionId, int chordId) const;
+    Chord getChordById(int sectionId, int chordId) const;
+    
     std::vector<Section> getSections() const;
     std::vector<Modulation> getModulations() const;
     std::pair<Section, Section> getAdjacentSections(const Modulation& modulation) const;
@@ -48,6 +93,13 @@ public:
     bool isComplete() const;
     
     int getTotalChordCount() const;
+    
+    /** @brief Indice global (dans toute la pièce) du premier accord de la section, en O(log n). */
+    int getSectionChordOffset(size_t sectionIndex) const;
+    int getGlobalChordIndex(size_t sectionIndex, int chordIndex) const;
+    
+    /** @brief {rang de section, indice local} de l'accord global ({-1, -1} hors bornes), en O(log n). */
+    std::pair<int, int> getChordLocation(int globalChordIndex) const;
     juce::String toString() const;
     juce::String getDetailedSummary() const;
     
@@ -59,14 +111,17 @@ public:
 private:
     juce::ValueTree state;
     juce::UndoManager undoManager;
+    PieceIndex index { state };         // Après state : se désabonne avant sa destruction
+    juce::ListenerList<Listener> listeners;
+    int editBatchDepth = 0;
     
-    int generateNextSectionId() const;
-    int generateNextModulationId() const;
+    int generateNextSectionId();
+    int generateNextModulationId();
+    int allocateId(const juce::Identifier& counter, const juce::Identifier& type);
+    static int scanNextId(const juce::ValueTree& parent, const juce::Identifier& type);
     
     juce::ValueTree createSectionNode(const juce::String& name);
     juce::ValueTree createModulationNode(int fromSectionId, int toSectionId);
     int findValueTreeIndex(const juce::Identifier& type, int id) const;
-    std::vector<juce::ValueTree> getChildrenOfType(const juce::Identifier& type) const;
-    juce::ValueTree getChildOfType(const juce::Identifier& type, size_t index) const;
     void assertInvariants() const;
 };
@@ -0,0 +1,253 @@
+#include "PieceFile.h"
+#include "ModelIdentifiers.h"
+#include <cstring>
+
+const juce::Identifier PieceFile::metadataType { "Metadata" };
+
+namespace
+{
+    const char magic[4] = { 'D', 'T', 'N', 'Y' };
+
+    void appendByte(juce::MemoryBlock& block, juce::uint8 value)
+    {
+        block.append(&value, 1);
+    }
+}
+
+//==============================================================================
+PieceFile::Summary PieceFile::summarise(const juce::ValueTree& pieceState)
+{
+    Summary summary;
+
+    for (const auto& child : pieceState)
+    {
+        if (child.hasType(ModelIdentifiers::SECTION))
+        {
+            if (summary.numSections == 0)
+            {
+                summary.startNote = child.getProperty(ModelIdentifiers::tonalityNote, 0);
+                summary.startIsMajor = child.getProperty(ModelIdentifiers::isMajor, true);
+            }
+            else
+            {
+                appendByte(summary.chordDegrees, sectionBreak);
+            }
+
+            ++summary.numSections;
+
+            const auto progression = child.getChildWithName(ModelIdentifiers::PROGRESSION);
+            summary.numChords += progression.getNumChildren();
+
+            for (const auto& chord : progression)
+            {
+                const int degree = chord.getProperty(ModelIdentifiers::degree, -1);
+                appendByte(summary.chordDegrees, static_cast<juce::uint8>(degree >= 0 && degree < sectionBreak ? degree : sectionBreak));
+            }
+        }
+        else if (child.hasType(ModelIdentifiers::MODULATION))
+        {
+            ++summary.numModulations;
+
+            const int type = child.getProperty(ModelIdentifiers::modulationType, -1);
+            if (type >= 0 && type < 8)
+                summary.modulationTypeMask |= 1 << type;
+        }
+    }
+
+    return summary;
+}
+
+//==============================================================================
+bool PieceFile::write(const juce::ValueTree& pieceState, const juce::File& file, const juce::ValueTree& metadata)
+{
+    if (!pieceState.hasType(ModelIdentifiers::PIECE))
+        return false;
+
+    const auto summary = summarise(pieceState);
+
+    juce::MemoryOutputStream pieceData;
+    pieceState.writeToStream(pieceData);
+
+    juce::MemoryOutputStream metadataData;
+    if (metadata.isValid())
+        metadata.writeToStream(metadataData);
+
+    // Écriture dans un fichier temporaire puis remplacement : un lecteur ne voit jamais un fichier partiel.
+    // Extension .tmp : le temporaire, créé dans le dossier surveillé, échappe au filtre "*.diatony"
+    juce::TemporaryFile temp(file, juce::File(file.getFullPathName() + ".tmp").getNonexistentSibling(false));
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk())
+            return false;
+
+        // En-tête fixe (headerSize octets, little-endian)
+        out.write(magic, sizeof(magic));
+        out.writeShort(static_cast<short>(formatVersion));
+        out.writeShort(static_cast<short>(headerSize));
+        out.writeByte(static_cast<char>(summary.startNote));
+        out.writeByte(summary.startIsMajor ? 1 : 0);
+        out.writeShort(static_cast<short>(juce::jmin(summary.numSections, 0xffff)));
+        out.writeShort(static_cast<short>(juce::jmin(summary.numModulations, 0xffff)));
+        out.writeByte(static_cast<char>(summary.modulationTypeMask));
+        out.writeByte(0);
+        out.writeInt(summary.numChords);
+        out.writeInt(static_cast<int>(summary.chordDegrees.getSize()));
+        out.writeInt(static_cast<int>(pieceData.getDataSize()));
+        out.writeInt(static_cast<int>(metadataData.getDataSize()));
+
+        out.write(summary.chordDegrees.getData(), summary.chordDegrees.getSize());
+        out.write(pieceData.getData(), pieceData.getDataSize());
+        out.write(metadataData.getData(), metadataData.getDataSize());
+
+        out.flush();
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+bool PieceFile::writeXml(const juce::ValueTree& pieceState, const juce::File& file, const juce::ValueTree& metadata)
+{
+    auto xml = pieceState.createXml();
+    if (xml == nullptr)
+        return false;
+
+    for (const auto& child : metadata)
+        if (auto childXml = child.createXml())
+            xml->addChildElement(childXml.release());
+
+    return xml->writeTo(file);
+}
+
+//==============================================================================
+bool PieceFile::isBinary(const juce::File& file)
+{
+    juce::FileInputStream in(file);
+    char bytes[sizeof(magic)] = {};
+    return in.openedOk() && in.read(bytes, sizeof(bytes)) == static_cast<int>(sizeof(bytes))
+        && std::memcmp(bytes, magic, sizeof(magic)) == 0;
+}
+
+bool PieceFile::readHeader(juce::InputStream& in, Header& header, Summary& summary)
+{
+    char bytes[sizeof(magic)] = {};
+    if (in.read(bytes, sizeof(bytes)) != static_cast<int>(sizeof(bytes)) || std::memcmp(bytes, magic, sizeof(magic)) != 0)
+        return false;
+
+    header.version = static_cast<juce::uint16>(in.readShort());
+    header.headerBytes = static_cast<juce::uint16>(in.readShort());
+
+    // Version plus récente : disposition inconnue. En-tête plus long : champs ajoutés, ignorés
+    if (header.version < 1 || header.version > formatVersion || header.headerBytes < headerSize)
+        return false;
+
+    summary.startNote = static_cast<juce::int8>(in.readByte());
+    summary.startIsMajor = (in.readByte() & 1) != 0;
+    summary.numSections = static_cast<juce::uint16>(in.readShort());
+    summary.numModulations = static_cast<juce::uint16>(in.readShort());
+    summary.modulationTypeMask = static_cast<juce::uint8>(in.readByte());
+    in.readByte();
+    summary.numChords = in.readInt();
+    header.degreesSize = static_cast<juce::uint32>(in.readInt());
+    header.pieceSize = static_cast<juce::uint32>(in.readInt());
+    header.metadataSize = static_cast<juce::uint32>(in.readInt());
+
+    const auto expectedLength = static_cast<juce::int64>(header.headerBytes) + header.degreesSize
+                              + header.pieceSize + header.metadataSize;
+    const auto totalLength = in.getTotalLength();
+    if (totalLength >= 0 && totalLength < expectedLength)
+        return false;
+
+    if (!in.setPosition(header.headerBytes))
+        return false;
+
+    summary.chordDegrees.reset();
+    return header.degreesSize == 0
+        || in.readIntoMemoryBlock(summary.chordDegrees, static_cast<juce::ssize_t>(header.degreesSize)) == header.degreesSize;
+}
+
+bool PieceFile::readSummary(const juce::File& file, Summary& summary)
+{
+    juce::FileInputStream in(file);
+    if (!in.openedOk())
+        return false;
+
+    Header header;
+    if (readHeader(in, header, summary))
+        return true;
+
+    if (isBinary(file))
+        return false;   // Binaire d'une autre version ou tronqué
+
+    auto state = readXml(file, nullptr);
+    if (!state.isValid())
+        return false;
+
+    summary = summarise(state);
+    return true;
+}
+
+juce::ValueTree PieceFile::read(const juce::File& file, juce::ValueTree* metadata)
+{
+    juce::FileInputStream in(file);
+    if (!in.openedOk())
+        return {};
+
+    Header header;
+    Summary summary;
+    if (!readHeader(in, header, summary))
+        return isBinary(file) ? juce::ValueTree() : readXml(file, metadata);
+
+    juce::MemoryBlock pieceData;
+    if (in.readIntoMemoryBlock(pieceData, static_cast<juce::ssize_t>(header.pieceSize)) != header.pieceSize)
+        return {};
+
+    auto state = juce::ValueTree::readFromData(pieceData.getData(), pieceData.getSize());
+    if (!state.hasType(ModelIdentifiers::PIECE))
+        return {};
+
+    if (metadata != nullptr)
+    {
+        *metadata = juce::ValueTree(metadataType);
+
+        juce::MemoryBlock metadataData;
+        if (header.metadataSize > 0
+            && in.readIntoMemoryBlock(metadataData, static_cast<juce::ssize_t>(header.metadataSize)) == header.metadataSize)
+        {
+            auto stored = juce::ValueTree::readFromData(metadataData.getData(), metadataData.getSize());
+            if (stored.isValid())
+                *metadata = stored;
+        }
+    }
+
+    return state;
+}
+
+juce::ValueTree PieceFile::readXml(const juce::File& file, juce::ValueTree* metadata)
+{
+    auto xml = juce::XmlDocument::parse(file);
+    if (xml == nullptr || !xml->hasTagName(ModelIdentifiers::PIECE.toString()))
+        return {};
+
+    auto state = juce::ValueTree::fromXml(*xml);
+    if (!state.isValid())
+        return {};
+
+    // Tout ce qui n'est ni Section ni Modulation (ex. statistiques de génération) est une métadonnée
+    juce::ValueTree extracted(metadataType);
+    for (int i = state.getNumChildren(); --i >= 0;)
+    {
+        auto child = state.getChild(i);
+        if (child.hasType(ModelIdentifiers::SECTION) || child.hasType(ModelIdentifiers::MODULATION))
+            continue;
+
+        state.removeChild(i, nullptr);
+        extracted.addChild(child, 0, nullptr);
+    }
+
+    if (metadata != nullptr)
+        *metadata = extracted;
+
+    return state;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+/**
+ * @brief Lecture/écriture des fichiers .diatony.
+ *
+ * Format binaire versionné : en-tête fixe (résumé de la pièce), bloc des degrés d'accords,
+ * ValueTree de la pièce (ValueTree::writeToStream), puis métadonnées optionnelles.
+ * readSummary() ne lit que l'en-tête et les degrés : aucun arbre n'est désérialisé.
+ * Le XML du ValueTree reste accepté en lecture (anciens fichiers, import) et en export.
+ */
+class PieceFile
+{
+public:
+    /** @brief Résumé stocké dans l'en-tête (ce qu'affiche et indexe l'historique). */
+    struct Summary
+    {
+        int startNote = -1;                 // Tonalité de la première section (-1 si aucune)
+        bool startIsMajor = true;
+        int numSections = 0;
+        int numModulations = 0;
+        int numChords = 0;
+        int modulationTypeMask = 0;         // Bit i : au moins une modulation de type i
+        juce::MemoryBlock chordDegrees;     // Degré de chaque accord, sections séparées par sectionBreak
+    };
+
+    static constexpr juce::uint8 sectionBreak = 0xff;
+    static constexpr int formatVersion = 1;
+    static constexpr int headerSize = 32;
+
+    /** @brief Calcule le résumé d'un arbre Piece. */
+    static Summary summarise(const juce::ValueTree& pieceState);
+
+    /** @brief Écrit au format binaire (remplacement atomique) ; metadata est optionnel. */
+    static bool write(const juce::ValueTree& pieceState, const juce::File& file,
+                      const juce::ValueTree& metadata = {});
+
+    /** @brief Export XML (un seul élément Piece, enfants de metadata ajoutés à la fin). */
+    static bool writeXml(const juce::ValueTree& pieceState, const juce::File& file,
+                         const juce::ValueTree& metadata = {});
+
+    /**
+     * @brief Lit l'arbre Piece (binaire ou XML) ; invalide en cas d'échec.
+     * Les métadonnées (en XML : enfants autres que Section/Modulation) sont retirées de la pièce
+     * et placées dans metadata si fourni.
+     */
+    static juce::ValueTree read(const juce::File& file, juce::ValueTree* metadata = nullptr);
+
+    /** @brief Lit le résumé : en-tête seul si binaire, sinon analyse XML complète. */
+    static bool readSummary(const juce::File& file, Summary& summary);
+
+    static bool isBinary(const juce::File& file);
+
+    static const juce::Identifier metadataType;
+
+private:
+    struct Header
+    {
+        int version = 0;
+        int headerBytes = 0;
+        juce::uint32 degreesSize = 0;
+        juce::uint32 pieceSize = 0;
+        juce::uint32 metadataSize = 0;
+    };
+
+    static bool readHeader(juce::InputStream& in, Header& header, Summary& summary);
+    static juce::ValueTree readXml(const juce::File& file, juce::ValueTree* metadata);
+};
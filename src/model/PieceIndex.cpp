@@ -0,0 +1,249 @@
+#include "PieceIndex.h"
+#include "ModelIdentifiers.h"
+
+PieceIndex::PieceIndex(juce::ValueTree& pieceRoot)
+    : root(pieceRoot)
+{
+    root.addListener(this);
+}
+
+PieceIndex::~PieceIndex()
+{
+    root.removeListener(this);
+}
+
+int PieceIndex::getNumSections() const
+{
+    ensureStructure();
+    return static_cast<int>(sections.size());
+}
+
+int PieceIndex::getNumModulations() const
+{
+    ensureStructure();
+    return static_cast<int>(modulations.size());
+}
+
+juce::ValueTree PieceIndex::getSection(int sectionIndex) const
+{
+    ensureStructure();
+    if (sectionIndex < 0 || sectionIndex >= static_cast<int>(sections.size()))
+        return {};
+    return sections[static_cast<size_t>(sectionIndex)];
+}
+
+juce::ValueTree PieceIndex::getModulation(int modulationIndex) const
+{
+    ensureStructure();
+    if (modulationIndex < 0 || modulationIndex >= static_cast<int>(modulations.size()))
+        return {};
+    return modulations[static_cast<size_t>(modulationIndex)];
+}
+
+int PieceIndex::getSectionIndexById(int id) const
+{
+    ensureStructure();
+    auto it = sectionIndexById.find(id);
+    return it != sectionIndexById.end() ? it->second : -1;
+}
+
+int PieceIndex::getModulationIndexById(int id) const
+{
+    ensureStructure();
+    auto it = modulationIndexById.find(id);
+    return it != modulationIndexById.end() ? it->second : -1;
+}
+
+int PieceIndex::getFirstChordIndex(int sectionIndex) const
+{
+    ensureStructure();
+    return chordOffsets.getOffset(juce::jlimit(0, chordOffsets.getNumSections(), sectionIndex));
+}
+
+int PieceIndex::getTotalChordCount() const
+{
+    ensureStructure();
+    return chordOffsets.getTotal();
+}
+
+int PieceIndex::findSectionForChord(int globalChordIndex) const
+{
+    ensureStructure();
+    return chordOffsets.findSection(globalChordIndex);
+}
+
+int PieceIndex::getChordIndexById(int sectionId, int chordId) const
+{
+    ensureStructure();
+    
+    auto cached = chordIndexById.find(sectionId);
+    if (cached == chordIndexById.end())
+    {
+        auto section = getSection(getSectionIndexById(sectionId));
+        if (!section.isValid())
+            return -1;
+        
+        auto progression = section.getChildWithName(ModelIdentifiers::PROGRESSION);
+        std::unordered_map<int, int> ranks;
+        ranks.reserve(static_cast<size_t>(progression.getNumChildren()));
+        for (int i = 0; i < progression.getNumChildren(); ++i)
+            ranks[progression.getChild(i).getProperty(ModelIdentifiers::id, -1)] = i;
+        
+        cached = chordIndexById.emplace(sectionId, std::move(ranks)).first;
+    }
+    
+    auto it = cached->second.find(chordId);
+    return it != cached->second.end() ? it->second : -1;
+}
+
+//==============================================================================
+void PieceIndex::ensureStructure() const
+{
+    if (!structureDirty)
+        return;
+
+    sections.clear();
+    modulations.clear();
+    sectionIndexById.clear();
+    modulationIndexById.clear();
+    chordIndexById.clear();
+    
+    std::vector<int> chordCounts;
+
+    for (int i = 0; i < root.getNumChildren(); ++i)
+    {
+        auto child = root.getChild(i);
+        const int id = child.getProperty(ModelIdentifiers::id, -1);
+
+        if (child.hasType(ModelIdentifiers::SECTION))
+        {
+            sectionIndexById[id] = static_cast<int>(sections.size());
+            sections.push_back(child);
+            chordCounts.push_back(child.getChildWithName(ModelIdentifiers::PROGRESSION).getNumChildren());
+        }
+        else if (child.hasType(ModelIdentifiers::MODULATION))
+        {
+            modulationIndexById[id] = static_cast<int>(modulations.size());
+            modulations.push_back(child);
+        }
+    }
+
+    chordOffsets.build(chordCounts);
+    structureDirty = false;
+}
+
+void PieceIndex::updateChordCount(const juce::ValueTree& parent, int delta)
+{
+    invalidateChordIds(parent);
+    
+    if (structureDirty)
+        return;
+
+    // Accord ajouté/retiré dans une progression de la pièce : mise à jour ponctuelle
+    auto section = parent.getParent();
+    if (parent.hasType(ModelIdentifiers::PROGRESSION) && section.getParent() == root)
+    {
+        const int sectionIndex = getSectionIndexById(section.getProperty(ModelIdentifiers::id, -1));
+        if (sectionIndex >= 0)
+        {
+            chordOffsets.add(sectionIndex, delta);
+            return;
+        }
+    }
+
+    // Autre changement sous une section (progression remplacée…) : reconstruction
+    structureDirty = true;
+}
+
+void PieceIndex::invalidateChordIds(const juce::ValueTree& progression)
+{
+    if (progression.hasType(ModelIdentifiers::PROGRESSION))
+        chordIndexById.erase(progression.getParent().getProperty(ModelIdentifiers::id, -1));
+    else
+        chordIndexById.clear();
+}
+
+//==============================================================================
+void PieceIndex::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property)
+{
+    if (property != ModelIdentifiers::id)
+        return;
+    
+    if (tree.getParent() == root)
+        structureDirty = true;
+    else if (tree.hasType(ModelIdentifiers::CHORD))
+        invalidateChordIds(tree.getParent());
+}
+
+void PieceIndex::valueTreeChildAdded(juce::ValueTree& parent, juce::ValueTree& child)
+{
+    if (parent != root)
+    {
+        updateChordCount(parent, +1);
+        return;
+    }
+
+    // Ajout en fin (cas de addSection) : mise à jour en place, sans reconstruction
+    if (structureDirty || root.getChild(root.getNumChildren() - 1) != child)
+    {
+        structureDirty = true;
+        return;
+    }
+
+    const int id = child.getProperty(ModelIdentifiers::id, -1);
+
+    if (child.hasType(ModelIdentifiers::SECTION))
+    {
+        sectionIndexById[id] = static_cast<int>(sections.size());
+        sections.push_back(child);
+        chordOffsets.pushBack(child.getChildWithName(ModelIdentifiers::PROGRESSION).getNumChildren());
+    }
+    else if (child.hasType(ModelIdentifiers::MODULATION))
+    {
+        modulationIndexById[id] = static_cast<int>(modulations.size());
+        modulations.push_back(child);
+    }
+}
+
+void PieceIndex::valueTreeChildRemoved(juce::ValueTree& parent, juce::ValueTree& child, int index)
+{
+    if (parent != root)
+    {
+        updateChordCount(parent, -1);
+        return;
+    }
+
+    // Retrait du dernier enfant : symétrique de l'ajout en fin
+    const bool wasLast = index == root.getNumChildren();
+    const int id = child.getProperty(ModelIdentifiers::id, -1);
+
+    if (!structureDirty && wasLast && !sections.empty() && sections.back() == child)
+    {
+        chordIndexById.erase(id);
+        sectionIndexById.erase(id);
+        sections.pop_back();
+        chordOffsets.popBack();
+    }
+    else if (!structureDirty && wasLast && !modulations.empty() && modulations.back() == child)
+    {
+        modulationIndexById.erase(id);
+        modulations.pop_back();
+    }
+    else
+    {
+        structureDirty = true;
+    }
+}
+
+void PieceIndex::valueTreeChildOrderChanged(juce::ValueTree& parent, int, int)
+{
+    if (parent == root)
+        structureDirty = true;
+    else
+        invalidateChordIds(parent);
+}
+
+void PieceIndex::valueTreeRedirected(juce::ValueTree&)
+{
+    structureDirty = true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+#include <unordered_map>
+#include <vector>
+#include "ChordOffsetTree.h"
+
+/**
+ * @brief Index de la pièce : rang ↔ nœud des sections/modulations, id → rang, décalages d'accords.
+ *
+ * Écoute le ValueTree racine de Piece. Les modifications ne font que marquer l'index sale ;
+ * il est reconstruit au premier accès suivant (O(n) une fois par lot d'éditions), puis les
+ * lectures sont en O(1). Les décalages d'accords vivent dans un arbre de Fenwick : un ajout/retrait
+ * d'accord le met à jour en O(log n), sans reconstruction. Les tables id → rang des accords sont
+ * construites par section à la demande et jetées dès que la progression change.
+ */
+class PieceIndex : private juce::ValueTree::Listener
+{
+public:
+    /** @brief S'abonne au handle racine (référence conservée : suit aussi les réaffectations). */
+    explicit PieceIndex(juce::ValueTree& pieceRoot);
+    ~PieceIndex() override;
+
+    int getNumSections() const;
+    int getNumModulations() const;
+
+    /** @brief Nœud au rang donné (ValueTree invalide hors bornes). */
+    juce::ValueTree getSection(int sectionIndex) const;
+    juce::ValueTree getModulation(int modulationIndex) const;
+
+    /** @brief Rang depuis l'id (-1 si inconnu). */
+    int getSectionIndexById(int id) const;
+    int getModulationIndexById(int id) const;
+
+    /** @brief Indice global du premier accord de la section (sectionIndex == count : nombre total d'accords). */
+    int getFirstChordIndex(int sectionIndex) const;
+    int getTotalChordCount() const;
+    
+    /** @brief Section contenant l'accord d'indice global donné (-1 hors bornes), en O(log n). */
+    int findSectionForChord(int globalChordIndex) const;
+    
+    /** @brief Rang de l'accord d'ID donné dans la section (-1 si inconnu) ; table construite au premier accès. */
+    int getChordIndexById(int sectionId, int chordId) const;
+
+private:
+    juce::ValueTree& root;
+
+    mutable std::vector<juce::ValueTree> sections;
+    mutable std::vector<juce::ValueTree> modulations;
+    mutable std::unordered_map<int, int> sectionIndexById;
+    mutable std::unordered_map<int, int> modulationIndexById;
+    mutable ChordOffsetTree chordOffsets;       // Un compte par section, dans l'ordre des rangs
+    mutable std::unordered_map<int, std::unordered_map<int, int>> chordIndexById;  // id de section → (id d'accord → rang)
+    mutable bool structureDirty = true;
+
+    void ensureStructure() const;
+    void updateChordCount(const juce::ValueTree& parent, int delta);
+    void invalidateChordIds(const juce::ValueTree& progression);
+
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+    void valueTreeChildAdded(juce::ValueTree& parent, juce::ValueTree& child) override;
+    void valueTreeChildRemoved(juce::ValueTree& parent, juce::ValueTree& child, int index) override;
+    void valueTreeChildOrderChanged(juce::ValueTree& parent, int oldIndex, int newIndex) override;
+    void valueTreeRedirected(juce::ValueTree& tree) override;
+
+    JUCE_DECLARE_NON_COPYABLE(PieceIndex)
+};
@@ -0,0 +1,67 @@
+#include "PieceSnapshot.h"
+#include "Piece.h"
+#include <unordered_map>
+
+PieceSnapshot::PieceSnapshot(const Piece& piece)
+    : title(piece.getTitle())
+{
+    auto pieceState = piece.getState();
+    const int numChildren = pieceState.getNumChildren();
+    
+    std::unordered_map<int, int> sectionIndexById;
+    std::vector<Modulation> modulationNodes;
+    
+    // Un seul parcours des enfants : sections et accords dans l'ordre, modulations résolues ensuite
+    for (int i = 0; i < numChildren; ++i)
+    {
+        auto child = pieceState.getChild(i);
+        
+        if (child.hasType(ModelIdentifiers::SECTION))
+        {
+            Section section(child);
+            auto progression = section.getProgression();
+            
+            SectionData data;
+            data.id = section.getId();
+            data.tonic = static_cast<int>(section.getNote());
+            data.isMajor = section.getIsMajor();
+            data.firstChordIndex = piece.getGlobalChordIndex(sections.size(), 0);
+            jassert(data.firstChordIndex == static_cast<int>(chords.size()));
+            data.chordCount = static_cast<int>(progression.size());
+            
+            for (size_t c = 0; c < progression.size(); ++c)
+            {
+                auto chord = progression.getChord(c);
+                chords.push_back({ static_cast<int>(chord.getDegree()),
+                                   static_cast<int>(chord.getQuality()),
+                                   static_cast<int>(chord.getChordState()) });
+            }
+            
+            sectionIndexById[data.id] = static_cast<int>(sections.size());
+            sections.push_back(data);
+        }
+        else if (child.hasType(ModelIdentifiers::MODULATION))
+        {
+            modulationNodes.emplace_back(child);
+        }
+    }
+    
+    auto indexOf = [&sectionIndexById](int sectionId)
+    {
+        auto it = sectionIndexById.find(sectionId);
+        return it != sectionIndexById.end() ? it->second : -1;
+    };
+    
+    modulations.reserve(modulationNodes.size());
+    for (const auto& modulation : modulationNodes)
+    {
+        ModulationData data;
+        data.id = modulation.getId();
+        data.type = static_cast<int>(modulation.getModulationType());
+        data.fromSectionIndex = indexOf(modulation.getFromSectionId());
+        data.toSectionIndex = indexOf(modulation.getToSectionId());
+        data.fromChordIndex = modulation.getFromChordIndex();
+        data.toChordIndex = modulation.getToChordIndex();
+        modulations.push_back(data);
+    }
+}
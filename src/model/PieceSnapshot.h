@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+class Piece;
+
+/**
+ * @brief Instantané immuable et aplati d'une Piece, destiné au thread du solveur.
+ *
+ * Construit une seule fois en O(n) sur le message thread, puis déplacé dans la requête.
+ * Uniquement des entiers en tableaux contigus : aucune référence vers le ValueTree vivant.
+ */
+class PieceSnapshot {
+public:
+    struct SectionData
+    {
+        int id = -1;
+        int tonic = 0;              // Diatony::Note
+        bool isMajor = true;
+        int firstChordIndex = 0;    // Index global du premier accord de la section (Piece::getGlobalChordIndex)
+        int chordCount = 0;
+    };
+    
+    struct ChordData
+    {
+        int degree = 0;             // Diatony::ChordDegree
+        int quality = -1;           // Diatony::ChordQuality (-1 = Auto, résolue par le solveur)
+        int state = 0;              // Diatony::ChordState
+    };
+    
+    struct ModulationData
+    {
+        int id = -1;
+        int type = 0;               // Diatony::ModulationType
+        int fromSectionIndex = -1;  // -1 si la section référencée n'existe pas
+        int toSectionIndex = -1;
+        int fromChordIndex = -1;    // Indices locaux bruts (-1 = calcul automatique)
+        int toChordIndex = -1;
+    };
+    
+    PieceSnapshot() = default;
+    explicit PieceSnapshot(const Piece& piece);
+    
+    const juce::String& getTitle() const { return title; }
+    bool isEmpty() const { return sections.empty() && modulations.empty(); }
+    
+    int getSectionCount() const { return static_cast<int>(sections.size()); }
+    int getModulationCount() const { return static_cast<int>(modulations.size()); }
+    int getTotalChordCount() const { return static_cast<int>(chords.size()); }
+    
+    const SectionData& getSection(int index) const { return sections[static_cast<size_t>(index)]; }
+    const ModulationData& getModulation(int index) const { return modulations[static_cast<size_t>(index)]; }
+    
+    /** @brief Indice global de l'accord chordIndex de la section, d'après les décalages relevés sur Piece. */
+    int getGlobalChordIndex(int sectionIndex, int chordIndex) const { return getSection(sectionIndex).firstChordIndex + chordIndex; }
+    
+    /** @brief Accord par index global (toutes sections confondues, dans l'ordre de la pièce). */
+    const ChordData& getChord(int globalIndex) const { return chords[static_cast<size_t>(globalIndex)]; }
+    
+    const std::vector<SectionData>& getSections() const { return sections; }
+    const std::vector<ChordData>& getChords() const { return chords; }
+    const std::vector<ModulationData>& getModulations() const { return modulations; }
+    
+private:
+    juce::String title;
+    std::vector<SectionData> sections;
+    std::vector<ChordData> chords;
+    std::vector<ModulationData> modulations;
+};
@@ -27,8 +27,9 @@ void Progression::removeChord(size_t index)
 
 void Progression::clear()
 {
-    if (state.isValid())
-        state.removeAllChildren(nullptr);
+    if (!state.isValid()) return;
+    state.removeAllChildren(nullptr);
+    state.setProperty(ModelIdentifiers::nextChordId, 0, nullptr);
 }
 
 Chord Progression::getChord(size_t index) const { validateIndex(index); return Chord(state.getChild(static_cast<int>(index))); }
@@ -36,17 +37,17 @@ Chord Progression::getChord(size_t index) { validateIndex(index); return Chord(s
 
 Chord Progression::getChordById(int id) const
 {
-    for (int i = 0; i < state.getNumChildren(); ++i)
-    {
-        auto child = state.getChild(i);
-        if (child.hasType(ModelIdentifiers::CHORD) && static_cast<int>(child.getProperty(ModelIdentifiers::id, -1)) == id)
-            return Chord(child);
-    }
-    return Chord(juce::ValueTree());
+    const int index = getChordIndexById(id);
+    return Chord(index >= 0 ? state.getChild(index) : juce::ValueTree());
 }
 
 int Progression::getChordIndexById(int id) const
 {
+    // Cas courant (ajouts en fin, sans retrait) : l'accord d'ID n est au rang n
+    auto candidate = state.getChild(id);
+    if (candidate.hasType(ModelIdentifiers::CHORD) && static_cast<int>(candidate.getProperty(ModelIdentifiers::id, -1)) == id)
+        return id;
+    
     for (int i = 0; i < state.getNumChildren(); ++i)
     {
         auto child = state.getChild(i);
@@ -67,16 +68,24 @@ juce::String Progression::toString() const
     return "Progression (ID=" + juce::String(getId()) + ", " + juce::String(size()) + " chords)";
 }
 
-int Progression::generateNextChordId() const
+int Progression::generateNextChordId()
 {
-    int maxId = -1;
-    for (int i = 0; i < state.getNumChildren(); ++i)
+    int nextId = state.getProperty(ModelIdentifiers::nextChordId, -1);
+    
+    // Compteur absent (progression d'un ancien fichier) : reconstruit une seule fois par balayage
+    if (nextId < 0)
     {
-        auto child = state.getChild(i);
-        if (child.hasType(ModelIdentifiers::CHORD))
-            maxId = std::max(maxId, static_cast<int>(child.getProperty(ModelIdentifiers::id, -1)));
+        nextId = 0;
+        for (int i = 0; i < state.getNumChildren(); ++i)
+        {
+            auto child = state.getChild(i);
+            if (child.hasType(ModelIdentifiers::CHORD))
+                nextId = std::max(nextId, static_cast<int>(child.getProperty(ModelIdentifiers::id, -1)) + 1);
+        }
     }
-    return maxId + 1;
+    
+    state.setProperty(ModelIdentifiers::nextChordId, nextId + 1, nullptr);
+    return nextId;
 }
 
 juce::ValueTree Progression::createChordNode(Diatony::ChordDegree degree, Diatony::ChordQuality quality, Diatony::ChordState chordState)
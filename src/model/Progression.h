@@ -8,7 +8,8 @@
 /**
  * @brief Wrapper autour d'un ValueTree représentant une progression harmonique.
  * 
- * Gère une collection ordonnée d'accords. Génère les IDs des Chords enfants.
+ * Gère une collection ordonnée d'accords. Génère les IDs des Chords enfants
+ * (compteur nextChordId stocké sur le nœud).
  * Pattern "vue" : ne stocke aucune donnée, délègue tout au ValueTree.
  */
 class Progression {
@@ -26,6 +27,7 @@ public:
     
     Chord getChord(size_t index) const;
     Chord getChord(size_t index);
+    /** @brief Recherche par ID : O(1) tant que ID == rang, balayage sinon (voir Piece::getChordIndexById). */
     Chord getChordById(int id) const;
     int getChordIndexById(int id) const;
     
@@ -41,7 +43,7 @@ public:
 private:
     juce::ValueTree state;
     
-    int generateNextChordId() const;
+    int generateNextChordId();
     juce::ValueTree createChordNode(Diatony::ChordDegree degree, Diatony::ChordQuality quality, Diatony::ChordState chordState);
     void validateIndex(size_t index) const;
 };
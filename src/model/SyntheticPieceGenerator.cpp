@@ -0,0 +1,144 @@
+#include "SyntheticPieceGenerator.h"
+
+using Diatony::ChordDegree;
+
+namespace
+{
+    /** @brief Dominante secondaire → degré sur lequel elle résout. */
+    bool getResolution(ChordDegree degree, ChordDegree& target)
+    {
+        switch (degree)
+        {
+            case ChordDegree::FiveOfTwo:         target = ChordDegree::Second;  return true;
+            case ChordDegree::FiveOfFour:        target = ChordDegree::Fourth;  return true;
+            case ChordDegree::FiveOfFive:        target = ChordDegree::Fifth;   return true;
+            case ChordDegree::FiveOfSix:         target = ChordDegree::Sixth;   return true;
+            case ChordDegree::FifthAppogiatura:  target = ChordDegree::Fifth;   return true;
+            default:                             return false;
+        }
+    }
+
+    template <size_t N>
+    ChordDegree pick(const ChordDegree (&choices)[N], juce::Random& random)
+    {
+        return choices[random.nextInt(static_cast<int>(N))];
+    }
+}
+
+void SyntheticPieceGenerator::generate(Piece& piece, const Options& options)
+{
+    juce::Random random(options.seed);
+
+    const int minSize = juce::jmax(2, options.minChordsPerSection);
+    const int maxSize = juce::jmax(minSize, options.maxChordsPerSection);
+    int remaining = juce::jmax(2, options.totalChords);
+
+    // Une seule notification pour toute la génération
+    Piece::ScopedEditBatch batch(piece, "Synthetic piece");
+
+    piece.clear();
+    piece.setTitle("Synthetic " + juce::String(remaining) + " chords (seed " + juce::String(options.seed) + ")");
+
+    while (remaining > 0)
+    {
+        // Dernière section : prend le reste ; sinon on laisse toujours de quoi faire une section valide
+        int size = remaining;
+        const int largestSplit = juce::jmin(maxSize, remaining - minSize);
+        if (remaining > maxSize && largestSplit >= minSize)
+            size = minSize + random.nextInt(largestSplit - minSize + 1);
+
+        piece.addSection("Section " + juce::String(piece.getSectionCount() + 1));
+
+        auto section = piece.getSection(piece.getSectionCount() - 1);
+        section.setNote(static_cast<Diatony::Note>(random.nextInt(12)));
+        section.setAlteration(Diatony::Alteration::Natural);
+        section.setIsMajor(random.nextBool());
+
+        fillProgression(section.getProgression(), size, random);
+        remaining -= size;
+    }
+
+    // Les 4 types apparaissent dès 5 sections, le reste est tiré au hasard
+    const int firstType = random.nextInt(4);
+    for (size_t i = 0; i < piece.getModulationCount(); ++i)
+    {
+        const int type = i < 4 ? (firstType + static_cast<int>(i)) % 4 : random.nextInt(4);
+        piece.getModulation(i).setModulationType(static_cast<Diatony::ModulationType>(type));
+    }
+
+    // Pièce de travail, pas une édition utilisateur
+    piece.getUndoManager().clearUndoHistory();
+}
+
+bool SyntheticPieceGenerator::writeToFile(const Piece& piece, const juce::File& file)
+{
+    if (auto xml = piece.getState().createXml())
+        return xml->writeTo(file);
+
+    return false;
+}
+
+void SyntheticPieceGenerator::fillProgression(Progression progression, int numChords, juce::Random& random)
+{
+    std::vector<ChordDegree> degrees;
+    degrees.reserve(static_cast<size_t>(numChords));
+
+    // Cadence parfaite finale V-I, précédée d'un parcours fonctionnel depuis I
+    const int bodyLength = numChords - 2;
+    if (bodyLength > 0)
+        degrees.push_back(ChordDegree::First);
+
+    while (static_cast<int>(degrees.size()) < bodyLength)
+    {
+        ChordDegree next = nextDegree(degrees.back(), random);
+
+        // Avant la cadence, seules les résolutions vers V restent correctes
+        ChordDegree target;
+        if (static_cast<int>(degrees.size()) == bodyLength - 1 && getResolution(next, target) && target != ChordDegree::Fifth)
+            next = ChordDegree::Fourth;
+
+        degrees.push_back(next);
+    }
+
+    degrees.push_back(ChordDegree::Fifth);
+    degrees.push_back(ChordDegree::First);
+
+    for (size_t i = 0; i < degrees.size(); ++i)
+    {
+        const bool isInner = i > 0 && i + 2 < degrees.size();
+        const bool canInvert = degrees[i] == ChordDegree::First || degrees[i] == ChordDegree::Fourth
+                            || degrees[i] == ChordDegree::Sixth;
+
+        const auto state = (isInner && canInvert && random.nextInt(5) == 0) ? Diatony::ChordState::FirstInversion
+                                                                               : Diatony::ChordState::Fundamental;
+        progression.addChord(degrees[i], Diatony::ChordQuality::Auto, state);
+    }
+}
+
+ChordDegree SyntheticPieceGenerator::nextDegree(ChordDegree current, juce::Random& random)
+{
+    ChordDegree target;
+    if (getResolution(current, target))
+        return target;
+
+    static const ChordDegree fromTonic[]       = { ChordDegree::Fourth, ChordDegree::Sixth, ChordDegree::Second,
+                                                   ChordDegree::Fifth, ChordDegree::FiveOfFour, ChordDegree::Third };
+    static const ChordDegree fromSubdominant[] = { ChordDegree::Fifth, ChordDegree::FifthAppogiatura, ChordDegree::First,
+                                                   ChordDegree::Second, ChordDegree::FiveOfFive };
+    static const ChordDegree fromSupertonic[]  = { ChordDegree::Fifth, ChordDegree::FifthAppogiatura, ChordDegree::Seventh };
+    static const ChordDegree fromSubmediant[]  = { ChordDegree::Second, ChordDegree::Fourth, ChordDegree::FiveOfTwo };
+    static const ChordDegree fromDominant[]    = { ChordDegree::First, ChordDegree::Sixth, ChordDegree::FiveOfSix };
+    static const ChordDegree fromMediant[]     = { ChordDegree::Sixth, ChordDegree::Fourth };
+
+    switch (current)
+    {
+        case ChordDegree::First:    return pick(fromTonic, random);
+        case ChordDegree::Second:   return pick(fromSupertonic, random);
+        case ChordDegree::Third:    return pick(fromMediant, random);
+        case ChordDegree::Fourth:   return pick(fromSubdominant, random);
+        case ChordDegree::Fifth:    return pick(fromDominant, random);
+        case ChordDegree::Sixth:    return pick(fromSubmediant, random);
+        case ChordDegree::Seventh:  return ChordDegree::First;
+        default:                    return ChordDegree::First;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "Piece.h"
+
+/**
+ * @brief Génère des pièces synthétiques valides et reproductibles (tests de charge, benchmarks).
+ *
+ * Progressions tirées d'une chaîne fonctionnelle tonique → sous-dominante → dominante,
+ * dominantes secondaires résolues sur leur degré cible, cadence V-I en fin de section.
+ * Sections majeures et mineures, les 4 ModulationType utilisés. Même graine = même pièce.
+ */
+class SyntheticPieceGenerator
+{
+public:
+    struct Options
+    {
+        int totalChords = 100;          // Nombre exact d'accords de la pièce
+        int minChordsPerSection = 4;    // >= 2 : contrainte de Diatony par progression
+        int maxChordsPerSection = 12;
+        juce::int64 seed = 1;
+    };
+
+    /** @brief Remplace le contenu de la pièce (sans undo) par une pièce générée. */
+    static void generate(Piece& piece, const Options& options);
+
+    /** @brief Écrit la pièce au format .diatony (XML du ValueTree). */
+    static bool writeToFile(const Piece& piece, const juce::File& file);
+
+private:
+    static void fillProgression(Progression progression, int numChords, juce::Random& random);
+    static Diatony::ChordDegree nextDegree(Diatony::ChordDegree current, juce::Random& random);
+};
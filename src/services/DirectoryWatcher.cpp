@@ -0,0 +1,311 @@
+#include "DirectoryWatcher.h"
+
+#if JUCE_LINUX
+ #include <sys/inotify.h>
+ #include <unistd.h>
+#endif
+
+DirectoryWatcher::DirectoryWatcher(const juce::File& directoryToWatch, const juce::String& fileWildcard,
+                                   Backend preferredBackend)
+    : juce::Thread("Directory Watcher"),
+      directory(directoryToWatch), wildcard(fileWildcard), preferred(preferredBackend)
+{
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+    stop();
+}
+
+void DirectoryWatcher::start()
+{
+    if (watching)
+        return;
+
+    watching = true;
+
+    {
+        const juce::ScopedLock lock(scanLock);
+        primed = false;
+        if (preferred == Backend::native)
+            openNative();
+    }
+
+    // Listage initial et relevés suivants hors du thread message (dossiers de milliers de fichiers)
+    startThread(juce::Thread::Priority::low);
+}
+
+void DirectoryWatcher::stop()
+{
+    stopThread(4000);
+    cancelPendingUpdate();
+
+    {
+        const juce::ScopedLock lock(scanLock);
+        closeNative();
+        knownFiles.clear();
+        primed = false;
+    }
+
+    {
+        const juce::ScopedLock lock(pendingLock);
+        pendingChanges.clear();
+        rescanPending = false;
+    }
+
+    watching = false;
+}
+
+DirectoryWatcher::Backend DirectoryWatcher::getBackend() const
+{
+    const juce::ScopedLock lock(scanLock);
+    return nativeHandle >= 0 ? Backend::native : Backend::polling;
+}
+
+void DirectoryWatcher::poll()
+{
+    if (!watching)
+        return;
+
+    {
+        const juce::ScopedLock lock(scanLock);
+        collectChanges();
+    }
+
+    dispatchPendingChanges();
+}
+
+void DirectoryWatcher::run()
+{
+    while (!threadShouldExit())
+    {
+        bool hasChanges = false;
+        {
+            const juce::ScopedLock lock(scanLock);
+            hasChanges = collectChanges();
+        }
+
+        if (hasChanges)
+            triggerAsyncUpdate();
+
+        wait(getBackend() == Backend::native ? nativeIntervalMs : pollingIntervalMs);
+    }
+}
+
+bool DirectoryWatcher::collectChanges()
+{
+    if (!primed)
+    {
+        auto initial = listFiles();
+        if (threadShouldExit())
+            return false;   // Listage interrompu par stop() : incomplet, donc ignoré
+
+        knownFiles = std::move(initial);
+        primed = true;
+    }
+    else if (nativeHandle >= 0)
+    {
+        pollNative();
+    }
+    else
+    {
+        pollListing();
+    }
+
+    const juce::ScopedLock lock(pendingLock);
+    return !pendingChanges.empty() || rescanPending;
+}
+
+void DirectoryWatcher::dispatchPendingChanges()
+{
+    std::vector<Change> changes;
+    bool rescan = false;
+    {
+        const juce::ScopedLock lock(pendingLock);
+        changes.swap(pendingChanges);
+        std::swap(rescan, rescanPending);
+    }
+
+    for (const auto& change : changes)
+        if (onChange)
+            onChange(directory.getChildFile(change.fileName), change.type);
+
+    if (rescan && onRescanNeeded)
+        onRescanNeeded();
+}
+
+DirectoryWatcher::StampMap DirectoryWatcher::listFiles() const
+{
+    StampMap files;
+    if (!directory.isDirectory())
+        return files;
+
+    for (const auto& entry : juce::RangedDirectoryIterator(directory, false, wildcard, juce::File::findFiles))
+    {
+        if (threadShouldExit())
+            break;
+
+        files[entry.getFile().getFileName()] = { entry.getModificationTime(), entry.getFileSize() };
+    }
+
+    return files;
+}
+
+void DirectoryWatcher::pollListing()
+{
+    auto current = listFiles();
+    if (threadShouldExit())
+        return;
+
+    for (const auto& [name, stamp] : current)
+    {
+        auto known = knownFiles.find(name);
+        if (known == knownFiles.end())
+        {
+            knownFiles[name] = stamp;
+            queueChange(name, ChangeType::added);
+        }
+        else if (!(known->second == stamp))
+        {
+            known->second = stamp;
+            queueChange(name, ChangeType::modified);
+        }
+    }
+
+    juce::StringArray removed;
+    for (const auto& known : knownFiles)
+        if (current.find(known.first) == current.end())
+            removed.add(known.first);
+
+    for (const auto& name : removed)
+        notifyRemoved(name);
+}
+
+void DirectoryWatcher::notifyPresent(const juce::String& fileName)
+{
+    auto file = directory.getChildFile(fileName);
+    if (!file.existsAsFile())
+        return;
+
+    const FileStamp stamp { file.getLastModificationTime(), file.getSize() };
+    auto known = knownFiles.find(fileName);
+    const bool isNew = known == knownFiles.end();
+
+    if (!isNew && known->second == stamp)
+        return;
+
+    knownFiles[fileName] = stamp;
+    queueChange(fileName, isNew ? ChangeType::added : ChangeType::modified);
+}
+
+void DirectoryWatcher::notifyRemoved(const juce::String& fileName)
+{
+    if (knownFiles.erase(fileName) > 0)
+        queueChange(fileName, ChangeType::removed);
+}
+
+void DirectoryWatcher::queueChange(const juce::String& fileName, ChangeType type)
+{
+    const juce::ScopedLock lock(pendingLock);
+    pendingChanges.push_back({ fileName, type });
+}
+
+//==============================================================================
+#if JUCE_LINUX
+
+bool DirectoryWatcher::openNative()
+{
+    nativeHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (nativeHandle < 0)
+        return false;
+
+    // Fichiers terminés (fermeture après écriture, renommage entrant) et disparitions
+    nativeWatch = inotify_add_watch(nativeHandle, directory.getFullPathName().toRawUTF8(),
+                                    IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM
+                                    | IN_DELETE_SELF | IN_MOVE_SELF);
+    if (nativeWatch < 0)
+    {
+        closeNative();
+        return false;
+    }
+
+    return true;
+}
+
+void DirectoryWatcher::closeNative()
+{
+    if (nativeHandle >= 0)
+        ::close(nativeHandle);
+
+    nativeHandle = -1;
+    nativeWatch = -1;
+}
+
+void DirectoryWatcher::pollNative()
+{
+    alignas(inotify_event) char buffer[4096];
+    bool overflowed = false;
+    bool directoryLost = false;
+
+    for (;;)
+    {
+        const auto length = ::read(nativeHandle, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;  // EAGAIN : file d'événements vide
+
+        for (char* cursor = buffer; cursor < buffer + length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                overflowed = true;
+                continue;
+            }
+
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+            {
+                directoryLost = true;
+                continue;
+            }
+
+            if (event->len == 0)
+                continue;
+
+            const auto name = juce::String::fromUTF8(event->name);
+            if (!name.matchesWildcard(wildcard, true))
+                continue;
+
+            if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                notifyRemoved(name);
+            else
+                notifyPresent(name);
+        }
+    }
+
+    // Dossier supprimé ou déplacé : la surveillance native ne voit plus rien, on bascule en polling
+    if (directoryLost)
+    {
+        closeNative();
+        pollListing();
+    }
+    else if (overflowed)
+    {
+        auto relisted = listFiles();
+        if (threadShouldExit())
+            return;
+
+        knownFiles = std::move(relisted);
+        const juce::ScopedLock lock(pendingLock);
+        rescanPending = true;
+    }
+}
+
+#else
+
+bool DirectoryWatcher::openNative() { return false; }
+void DirectoryWatcher::closeNative() {}
+void DirectoryWatcher::pollNative() {}
+
+#endif
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Surveille les fichiers d'un dossier et signale ajouts, modifications et suppressions.
+ *
+ * Sous Linux, les événements viennent d'inotify ; ailleurs, ou si inotify est indisponible, le dossier
+ * est relisté périodiquement et comparé par date/taille. Relevés et listages tournent sur un thread
+ * dédié : seuls les deltas sont postés au thread message, où les callbacks sont appelés.
+ * Aucun contenu de fichier n'est lu.
+ */
+class DirectoryWatcher : private juce::Thread,
+                         private juce::AsyncUpdater
+{
+public:
+    enum class ChangeType { added, modified, removed };
+    enum class Backend { native, polling };
+
+    DirectoryWatcher(const juce::File& directoryToWatch, const juce::String& fileWildcard,
+                     Backend preferredBackend = Backend::native);
+    ~DirectoryWatcher() override;
+
+    std::function<void(const juce::File&, ChangeType)> onChange;
+
+    /** @brief Des événements ont été perdus (file noyau saturée) : l'appelant doit resynchroniser. */
+    std::function<void()> onRescanNeeded;
+
+    /** @brief Surveille le dossier ; l'état initial est relevé sur le thread de surveillance. Sans effet si déjà démarré. */
+    void start();
+    void stop();
+    bool isWatching() const { return watching; }
+
+    /** @brief Relève et signale immédiatement les changements, sur le thread appelant (tests, rafraîchissement forcé). */
+    void poll();
+
+    Backend getBackend() const;
+
+    static constexpr int nativeIntervalMs = 250;
+    static constexpr int pollingIntervalMs = 2000;
+
+private:
+    struct FileStamp
+    {
+        juce::Time modificationTime;
+        juce::int64 size = 0;
+
+        bool operator==(const FileStamp& other) const
+        {
+            return size == other.size && modificationTime.toMilliseconds() == other.modificationTime.toMilliseconds();
+        }
+    };
+    using StampMap = std::unordered_map<juce::String, FileStamp>;
+
+    struct Change
+    {
+        juce::String fileName;
+        ChangeType type;
+    };
+
+    juce::File directory;
+    juce::String wildcard;
+    Backend preferred;
+    bool watching = false;
+
+    juce::CriticalSection scanLock;     // Protège l'état ci-dessous (thread de surveillance ou poll())
+    StampMap knownFiles;                // Nom → date/taille au dernier relevé
+    bool primed = false;                // État initial relevé
+    int nativeHandle = -1;              // Descripteur inotify (-1 : mode polling)
+    int nativeWatch = -1;
+
+    juce::CriticalSection pendingLock;
+    std::vector<Change> pendingChanges; // Deltas en attente de livraison au thread message
+    bool rescanPending = false;
+
+    void run() override;
+    void handleAsyncUpdate() override { dispatchPendingChanges(); }
+
+    /** @brief Relève les changements (scanLock tenu) ; retourne true si des deltas sont en attente. */
+    bool collectChanges();
+    void dispatchPendingChanges();
+
+    StampMap listFiles() const;
+    void pollNative();
+    void pollListing();
+    void notifyPresent(const juce::String& fileName);
+    void notifyRemoved(const juce::String& fileName);
+    void queueChange(const juce::String& fileName, ChangeType type);
+    bool openNative();
+    void closeNative();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DirectoryWatcher)
+};
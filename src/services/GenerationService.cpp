@@ -1,4 +1,6 @@
 #include "GenerationService.h"
+#include "VoicingMidiWriter.h"
+#include "../utils/FileUtils.h"
 #include "../controller/AppController.h"
 #include "../model/DiatonyTypes.h"
 #include "../model/Section.h"
@@ -14,9 +16,16 @@
 #include "../../Diatony/c++/headers/diatony/FourVoiceTextureParameters.hpp"
 #include "../../Diatony/c++/headers/diatony/FourVoiceTexture.hpp"
 #include "../../Diatony/c++/headers/diatony/ModulationParameters.hpp"
-#include "../../Diatony/c++/headers/aux/MidiFileGeneration.hpp"
 #include "../../Diatony/c++/headers/diatony/SolveDiatony.hpp"
 
+#include <gecode/search.hh>
+#include <gecode/int.hh>
+#include <set>
+
+#if JUCE_MAC || JUCE_LINUX
+ #include <sys/resource.h>
+#endif
+
 struct GenerationService::Impl {
     bool initialized = false;
 };
@@ -62,6 +71,252 @@ namespace {
     }
 
     #undef VALIDATE_ENUM_MAPPING
+
+    //==============================================================================
+    // Portfolio de recherches
+    //==============================================================================
+
+    /**
+     * Les branchements sont postés par le constructeur de FourVoiceTexture : on ne peut pas
+     * les changer côté application. La diversification passe donc par le moteur de recherche
+     * (DFS, BAB, redémarrages avec nogoods et cutoffs aléatoires/Luby de graines différentes).
+     */
+    enum class SearchStrategy { DepthFirst, BranchAndBound, RestartRandom, RestartLuby };
+
+    SearchStrategy strategyForWorker(int workerIndex)
+    {
+        switch (workerIndex % 4)
+        {
+            case 0:  return SearchStrategy::DepthFirst;       // Comportement historique (solve_diatony)
+            case 1:  return SearchStrategy::BranchAndBound;
+            case 2:  return SearchStrategy::RestartRandom;
+            default: return SearchStrategy::RestartLuby;
+        }
+    }
+
+    /** @brief Première solution du moteur, avec ses statistiques de recherche. */
+    template <class Engine>
+    FourVoiceTexture* nextWithStatistics(Engine& engine, Gecode::Search::Statistics& stats)
+    {
+        FourVoiceTexture* solution = engine.next();
+        stats = engine.statistics();
+        return solution;
+    }
+
+    /** @brief Pic de mémoire résidente du processus (0 si indisponible). */
+    juce::int64 getPeakResidentMemoryBytes()
+    {
+       #if JUCE_MAC || JUCE_LINUX
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+        
+        #if JUCE_MAC
+        return static_cast<juce::int64>(usage.ru_maxrss);          // Octets sur macOS
+        #else
+        return static_cast<juce::int64>(usage.ru_maxrss) * 1024;   // Kio sur Linux
+        #endif
+       #else
+        return 0;
+       #endif
+    }
+
+    void accumulate(GenerationStats& target, const Gecode::Search::Statistics& stats)
+    {
+        target.nodes += static_cast<juce::int64>(stats.node);
+        target.fails += static_cast<juce::int64>(stats.fail);
+        target.restarts += static_cast<juce::int64>(stats.restart);
+        target.nogoods += static_cast<juce::int64>(stats.nogood);
+        target.propagations += static_cast<juce::int64>(stats.propagate);
+        target.peakDepth = juce::jmax(target.peakDepth, static_cast<int>(stats.depth));
+    }
+
+    /** @brief État partagé par les workers : la première solution gagne. */
+    struct PortfolioState
+    {
+        FourVoiceTextureParameters* params = nullptr;
+        const std::vector<int>* pinnedVoicing = nullptr;   // Re-résolution incrémentale (-1 = note libre)
+        std::atomic<bool> solved { false };
+        
+        // Arrêts externes : annulation utilisateur et budget de la requête
+        const std::atomic<bool>* cancelled = nullptr;
+        double deadlineMs = 0.0;                    // 0 = pas de limite de temps
+        unsigned long nodeLimit = 0;                // 0 = pas de limite de nœuds
+        std::atomic<bool> budgetExhausted { false };
+        
+        juce::CriticalSection lock;
+        GenerationStats searchStats;                // Somme sur tous les workers (profondeur : max)
+        FourVoiceTexture* solution = nullptr;
+        int winningWorker = -1;
+        double solvedAtMs = 0.0;
+    };
+
+    /**
+     * @brief Stop Gecode : interrompt la recherche si un autre worker a trouvé une solution,
+     * si l'utilisateur annule ou si le budget temps/nœuds est épuisé.
+     */
+    class PortfolioStop : public Gecode::Search::Stop
+    {
+    public:
+        explicit PortfolioStop(PortfolioState& sharedState) : state(sharedState) {}
+        
+        bool stop(const Gecode::Search::Statistics& stats, const Gecode::Search::Options&) override
+        {
+            if (state.solved.load(std::memory_order_relaxed))
+                return true;
+            
+            if (state.cancelled != nullptr && state.cancelled->load(std::memory_order_relaxed))
+                return true;
+            
+            const bool outOfNodes = state.nodeLimit > 0 && stats.node >= state.nodeLimit;
+            const bool outOfTime = state.deadlineMs > 0.0
+                                   && juce::Time::getMillisecondCounterHiRes() >= state.deadlineMs;
+            
+            if (outOfNodes || outOfTime)
+            {
+                state.budgetExhausted.store(true);
+                return true;
+            }
+            
+            return false;
+        }
+        
+    private:
+        PortfolioState& state;
+    };
+
+    /** @brief Stop du mode anytime : l'échéance d'optimisation ne coupe qu'après une première solution. */
+    class AnytimeStop : public Gecode::Search::Stop
+    {
+    public:
+        AnytimeStop(PortfolioState& sharedState, double optimiseDeadline)
+            : budgetStop(sharedState), optimiseDeadlineMs(optimiseDeadline) {}
+        
+        bool stop(const Gecode::Search::Statistics& stats, const Gecode::Search::Options& options) override
+        {
+            if (hasSolution.load(std::memory_order_relaxed)
+                && juce::Time::getMillisecondCounterHiRes() >= optimiseDeadlineMs)
+                return true;
+            
+            return budgetStop.stop(stats, options);
+        }
+        
+        std::atomic<bool> hasSolution { false };
+        
+    private:
+        PortfolioStop budgetStop;
+        double optimiseDeadlineMs;
+    };
+
+    /** @brief Une recherche du portfolio, sur sa propre copie du modèle Gecode. */
+    class PortfolioWorker : public juce::Thread
+    {
+    public:
+        PortfolioWorker(PortfolioState& sharedState, int index)
+            : juce::Thread("Diatony Portfolio Worker " + juce::String(index)),
+              state(sharedState), workerIndex(index), stopObject(sharedState) {}
+        
+        ~PortfolioWorker() override { stopThread(-1); }
+        
+        void run() override
+        {
+            try
+            {
+                std::unique_ptr<FourVoiceTexture> model(new FourVoiceTexture(state.params));
+                
+                if (state.pinnedVoicing != nullptr && !pinVoicing(*model, *state.pinnedVoicing))
+                    return;  // Voicings figés incompatibles : le repli sur résolution complète s'en charge
+                
+                Gecode::Search::Options opts;
+                opts.threads = 1;
+                opts.stop = &stopObject;
+                
+                Gecode::Search::Statistics stats;
+                FourVoiceTexture* solution = search(model.get(), opts, stats);
+                
+                {
+                    const juce::ScopedLock lock(state.lock);
+                    accumulate(state.searchStats, stats);
+                }
+                
+                if (solution != nullptr)
+                    publish(solution);
+            }
+            catch (const std::exception&)
+            {
+                // Un worker en échec n'invalide pas le portfolio : les autres continuent
+            }
+        }
+        
+    private:
+        PortfolioState& state;
+        int workerIndex;
+        PortfolioStop stopObject;
+        
+        /** @brief Fige les notes connues ; la recherche ne porte plus que sur les notes libres. */
+        static bool pinVoicing(FourVoiceTexture& model, const std::vector<int>& pinned)
+        {
+            auto fullVoicing = model.getFullVoicing();
+            const int numVars = juce::jmin(fullVoicing.size(), static_cast<int>(pinned.size()));
+            
+            for (int i = 0; i < numVars; ++i)
+                if (pinned[static_cast<size_t>(i)] >= 0)
+                    Gecode::rel(model, fullVoicing[i], Gecode::IRT_EQ, pinned[static_cast<size_t>(i)]);
+            
+            return model.status() != Gecode::SS_FAILED;
+        }
+        
+        FourVoiceTexture* search(FourVoiceTexture* model, Gecode::Search::Options& opts,
+                                 Gecode::Search::Statistics& stats)
+        {
+            const auto seed = static_cast<unsigned int>(workerIndex + 1);
+            
+            switch (strategyForWorker(workerIndex))
+            {
+                case SearchStrategy::DepthFirst:
+                {
+                    Gecode::DFS<FourVoiceTexture> engine(model, opts);
+                    return nextWithStatistics(engine, stats);
+                }
+                case SearchStrategy::BranchAndBound:
+                {
+                    Gecode::BAB<FourVoiceTexture> engine(model, opts);
+                    return nextWithStatistics(engine, stats);
+                }
+                case SearchStrategy::RestartRandom:
+                {
+                    opts.nogoods_limit = 128;
+                    opts.cutoff = Gecode::Search::Cutoff::rnd(seed, 50, 5000, 50);
+                    Gecode::RBS<FourVoiceTexture, Gecode::DFS> engine(model, opts);
+                    return nextWithStatistics(engine, stats);
+                }
+                case SearchStrategy::RestartLuby:
+                default:
+                {
+                    opts.nogoods_limit = 128;
+                    opts.cutoff = Gecode::Search::Cutoff::luby(100u * seed);
+                    Gecode::RBS<FourVoiceTexture, Gecode::DFS> engine(model, opts);
+                    return nextWithStatistics(engine, stats);
+                }
+            }
+        }
+        
+        void publish(FourVoiceTexture* solution)
+        {
+            const juce::ScopedLock lock(state.lock);
+            
+            if (state.solution != nullptr)
+            {
+                delete solution;  // Un autre worker a gagné entre-temps
+                return;
+            }
+            
+            state.solution = solution;
+            state.winningWorker = workerIndex;
+            state.solvedAtMs = juce::Time::getMillisecondCounterHiRes();
+            state.solved.store(true);
+        }
+    };
 }
 
 GenerationService::GenerationService() 
@@ -73,53 +328,179 @@ GenerationService::GenerationService()
     pImpl->initialized = true;
     ready = true;
     lastError.clear();
+    
+    // Partagé entre sessions et instances : le fichier n'est mappé qu'au premier lookup
+    solutionCache->attachPersistentStore(FileUtils::getSolutionCacheFile());
 }
 
 GenerationService::~GenerationService()
 {
-    stopThread(-1); // Attendre que le thread se termine
-}
-
-bool GenerationService::startGeneration(const Piece& piece, const juce::String& outputPath, AppController* controller)
-{
-    if (isThreadRunning())
+    // Plus de callback vers un contrôleur en cours de destruction
     {
-        lastError = "Une génération est déjà en cours";
-        return false;
+        juce::ScopedLock lock(callbackLock);
+        appController = nullptr;
     }
     
+    // Le stop Gecode voit l'annulation au nœud suivant : l'attente reste courte
+    cancelGeneration();
+    signalThreadShouldExit();
+    jobAvailable.signal();
+    stopThread(5000);
+}
+
+bool GenerationService::startGeneration(const Piece& piece, const juce::String& outputPath, AppController* controller,
+                                        const GenerationBudget& budget)
+{
     if (!ready)
     {
         lastError = "Service not ready";
         return false;
     }
     
-    pieceToGenerate = &piece;
-    outputPathToGenerate = outputPath;
+    // Instantané aplati en O(n) : le worker ne touche jamais l'arbre vivant de l'UI
+    auto job = std::make_unique<GenerationJob>();
+    job->snapshot = PieceSnapshot(piece);
+    job->outputPath = outputPath;
+    job->budget = budget;
     
     {
         juce::ScopedLock lock(callbackLock);
         appController = controller;
     }
     
-    generationSuccess.store(false);
-    lastError.clear();
-    startThread();
+    {
+        const juce::ScopedLock lock(queueLock);
+        job->id = ++latestJobId;
+        pendingJob = std::move(job);  // Remplace (abandonne) une requête en attente plus ancienne
+        
+        // Une requête asynchrone en cours est désormais obsolète : on l'interrompt.
+        // Une résolution synchrone (generateNow) va à son terme ; le worker attend sa fin.
+        if (runningJobId != 0 && !synchronousJobRunning)
+            cancelRequested.store(true);
+    }
     
+    if (!isThreadRunning())
+        startThread();
+    
+    jobAvailable.signal();
     return true;
 }
 
+GenerationResult GenerationService::generateNow(const Piece& piece, const juce::String& outputPath,
+                                                const GenerationBudget& budget)
+{
+    GenerationJob job;
+    job.snapshot = PieceSnapshot(piece);
+    job.outputPath = outputPath;
+    job.budget = budget;
+    job.synchronous = true;
+    
+    {
+        const juce::ScopedLock lock(queueLock);
+        
+        // Le thread worker partage l'état de résolution : pas de mélange avec startGeneration()
+        if (!ready || pendingJob != nullptr || runningJobId != 0)
+        {
+            GenerationResult busy;
+            busy.error = ready ? "A generation is already running" : "Service not ready";
+            return busy;
+        }
+        
+        job.id = ++latestJobId;
+        runningJobId = job.id;
+        synchronousJobRunning = true;
+        cancelRequested.store(false);
+    }
+    
+    processJob(job);
+    auto result = getLastResult();
+    
+    bool hasDeferredJob = false;
+    {
+        const juce::ScopedLock lock(queueLock);
+        runningJobId = 0;
+        synchronousJobRunning = false;
+        hasDeferredJob = pendingJob != nullptr;
+    }
+    
+    // Requête arrivée pendant la résolution synchrone : le worker peut la prendre
+    if (hasDeferredJob)
+        jobAvailable.signal();
+    
+    return result;
+}
+
 void GenerationService::run()
 {
-    if (pieceToGenerate == nullptr)
+    while (!threadShouldExit())
     {
-        generationSuccess.store(false);
-        lastError = "Piece invalide (nullptr)";
-        return;
+        std::unique_ptr<GenerationJob> job;
+        {
+            const juce::ScopedLock lock(queueLock);
+            
+            // Pas de processJob concurrent : l'état de résolution est partagé avec generateNow()
+            if (!synchronousJobRunning)
+                job = std::move(pendingJob);
+            
+            if (job != nullptr)
+            {
+                runningJobId = job->id;
+                cancelRequested.store(false);
+            }
+        }
+        
+        if (job == nullptr)
+        {
+            jobAvailable.wait(-1);
+            continue;
+        }
+        
+        processJob(*job);
+        
+        const juce::ScopedLock lock(queueLock);
+        runningJobId = 0;
+    }
+}
+
+void GenerationService::processJob(GenerationJob& job)
+{
+    {
+        const juce::ScopedLock lock(resultLock);
+        lastResult = GenerationResult();
+        lastResult.jobId = job.id;
     }
     
-    bool success = generateMidiFromPiece(*pieceToGenerate, outputPathToGenerate);
-    generationSuccess.store(success);
+    budgetForRequest = job.budget;
+    currentJobId = job.id;
+    currentJobSynchronous = job.synchronous;
+    resultDelivered = false;
+    
+    const double jobStartMs = juce::Time::getMillisecondCounterHiRes();
+    
+    bool success = generateMidiFromPiece(job.snapshot, job.outputPath);
+    
+    {
+        const juce::ScopedLock lock(resultLock);
+        lastResult.stats.totalMs = juce::Time::getMillisecondCounterHiRes() - jobStartMs;
+        lastResult.stats.peakMemoryBytes = getPeakResidentMemoryBytes();
+    }
+    
+    // En mode énumération, la première solution a déjà été livrée avant la recherche des suivantes
+    if (!resultDelivered)
+        deliverResult(success);
+}
+
+bool GenerationService::isLatestJob(int jobId) const
+{
+    const juce::ScopedLock lock(queueLock);
+    return jobId == latestJobId;
+}
+
+void GenerationService::notifyController()
+{
+    // L'appelant de generateNow() lit le résultat retourné et la file de solutions lui-même
+    if (currentJobSynchronous)
+        return;
     
     AppController* controllerToNotify = nullptr;
     {
@@ -131,11 +512,247 @@ void GenerationService::run()
         controllerToNotify->triggerAsyncUpdate();
 }
 
-bool GenerationService::isGenerating() const { return isThreadRunning(); }
+void GenerationService::deliverResult(bool success)
+{
+    resultDelivered = true;
+    
+    {
+        // Livraison anticipée (énumération) : le total couvre au moins la première solution
+        const juce::ScopedLock lock(resultLock);
+        if (lastResult.stats.totalMs == 0.0)
+        {
+            auto& stats = lastResult.stats;
+            stats.totalMs = stats.paramsMs + stats.solveMs + stats.midiWriteMs;
+            stats.peakMemoryBytes = getPeakResidentMemoryBytes();
+        }
+    }
+    
+    // Une requête plus récente existe : ce résultat est périmé, on ne le livre pas
+    if (!isLatestJob(currentJobId))
+        return;
+    
+    generationSuccess.store(success);
+    
+    {
+        const juce::ScopedLock lock(resultLock);
+        lastResult.success = success;
+        lastResult.midiPath = success ? lastGeneratedMidiPath : juce::String();
+        lastResult.cancelled = !success && isCancellationRequested();
+        lastResult.error = lastError;
+        lastResult.inputValidationError = inputValidationError;
+    }
+    
+    notifyController();
+}
+
+void GenerationService::enumerateAlternatives(FourVoiceTextureParameters* pieceParams,
+                                              const std::vector<int>& firstVoicing,
+                                              int requestedCount,
+                                              const juce::File& firstMidiFile)
+{
+    const int jobId = currentJobId;
+    
+    auto streamSolution = [this, jobId, requestedCount](int index, bool isLast, const juce::String& path)
+    {
+        if (!isLatestJob(jobId))
+            return;
+        
+        solutionStream.push({ jobId, index, requestedCount, isLast, path });
+        notifyController();
+    };
+    
+    streamSolution(1, false, firstMidiFile.getFullPathName());
+    
+    // Même stop que le portfolio (annulation, requête plus récente, budget), sans "solved" partagé
+    PortfolioState state;
+    state.params = pieceParams;
+    state.cancelled = &cancelRequested;
+    state.nodeLimit = budgetForRequest.nodeLimit;
+    if (budgetForRequest.timeLimitMs > 0)
+        state.deadlineMs = juce::Time::getMillisecondCounterHiRes() + budgetForRequest.timeLimitMs;
+    
+    PortfolioStop stopObject(state);
+    int found = 1;
+    
+    try
+    {
+        std::unique_ptr<FourVoiceTexture> model(new FourVoiceTexture(pieceParams));
+        
+        Gecode::Search::Options opts;
+        opts.threads = 1;
+        opts.stop = &stopObject;
+        Gecode::DFS<FourVoiceTexture> engine(model.get(), opts);
+        
+        std::set<std::vector<int>> seen { firstVoicing };
+        
+        while (found < requestedCount && !isCancellationRequested())
+        {
+            std::unique_ptr<FourVoiceTexture> solution(engine.next());
+            
+            {
+                const juce::ScopedLock lock(resultLock);
+                lastResult.enumerationStats = GenerationStats();
+                accumulate(lastResult.enumerationStats, engine.statistics());
+            }
+            
+            if (solution == nullptr)
+                break;
+            
+            auto voicing = extractVoicing(solution.get());
+            if (!seen.insert(voicing).second)
+                continue;  // Déjà livrée (typiquement la solution du portfolio)
+            
+            juce::File alternativeFile = firstMidiFile.getSiblingFile(
+                firstMidiFile.getFileNameWithoutExtension() + "_alt" + juce::String(found + 1) + ".mid");
+            
+            juce::String writeError;
+            if (!VoicingMidiWriter::write(voicing, alternativeFile, writeError))
+                break;
+            
+            ++found;
+            streamSolution(found, found == requestedCount, alternativeFile.getFullPathName());
+        }
+    }
+    catch (const std::exception&)
+    {
+        // Les solutions déjà livrées restent valides
+    }
+    
+    // Fin de l'énumération (espace épuisé, annulation ou budget) : le compte final est connu
+    if (found < requestedCount)
+        streamSolution(found, true, juce::String());
+}
+
+bool GenerationService::isGenerating() const
+{
+    const juce::ScopedLock lock(queueLock);
+    return pendingJob != nullptr || runningJobId != 0;
+}
+
+int GenerationService::getLatestJobId() const
+{
+    const juce::ScopedLock lock(queueLock);
+    return latestJobId;
+}
+
 bool GenerationService::getLastGenerationSuccess() const { return generationSuccess.load(); }
 juce::String GenerationService::getLastGeneratedMidiPath() const { return lastGeneratedMidiPath; }
 
-bool GenerationService::generateMidiFromPiece(const Piece& piece, const juce::String& outputPath) {
+void GenerationService::cancelGeneration()
+{
+    const juce::ScopedLock lock(queueLock);
+    pendingJob.reset();
+    cancelRequested.store(true);
+}
+
+bool GenerationService::isCancellationRequested() const
+{
+    return cancelRequested.load() || threadShouldExit();
+}
+
+GenerationResult GenerationService::getLastResult() const
+{
+    const juce::ScopedLock lock(resultLock);
+    return lastResult;
+}
+
+void GenerationService::setPortfolioSize(int numWorkers) { portfolioSize.store(juce::jmax(1, numWorkers)); }
+int GenerationService::getPortfolioSize() const { return portfolioSize.load(); }
+
+int GenerationService::getDefaultPortfolioSize()
+{
+    // On laisse un cœur libre pour le thread audio et le message thread du DAW
+    return juce::jlimit(1, 8, juce::SystemStats::getNumCpus() - 1);
+}
+
+FourVoiceTexture* GenerationService::solvePortfolio(FourVoiceTextureParameters* pieceParams,
+                                                   const std::vector<int>* pinnedVoicing)
+{
+    const int numWorkers = getPortfolioSize();
+    
+    PortfolioState state;
+    state.params = pieceParams;
+    state.pinnedVoicing = pinnedVoicing;
+    state.cancelled = &cancelRequested;
+    state.nodeLimit = budgetForRequest.nodeLimit;
+    
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+    if (budgetForRequest.timeLimitMs > 0)
+        state.deadlineMs = startMs + budgetForRequest.timeLimitMs;
+    
+    std::vector<std::unique_ptr<PortfolioWorker>> workers;
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<PortfolioWorker>(state, i));
+        workers.back()->startThread();
+    }
+    
+    // Tous les workers s'arrêtent d'eux-mêmes : solution trouvée (stop partagé) ou espace épuisé
+    for (auto& worker : workers)
+        worker->waitForThreadToExit(-1);
+    
+    {
+        const juce::ScopedLock lock(resultLock);
+        lastResult.portfolioSize = numWorkers;
+        lastResult.winningWorker = state.winningWorker;
+        lastResult.timeToFirstSolutionMs = state.solution != nullptr ? state.solvedAtMs - startMs : 0.0;
+        lastResult.budgetExhausted = state.solution == nullptr && state.budgetExhausted.load();
+        lastResult.stats.merge(state.searchStats);
+    }
+    
+    return state.solution;
+}
+
+FourVoiceTexture* GenerationService::solveAnytime(FourVoiceTextureParameters* pieceParams, int optimiseForMs)
+{
+    PortfolioState state;
+    state.params = pieceParams;
+    state.cancelled = &cancelRequested;
+    state.nodeLimit = budgetForRequest.nodeLimit;
+    
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+    if (budgetForRequest.timeLimitMs > 0)
+        state.deadlineMs = startMs + budgetForRequest.timeLimitMs;
+    
+    AnytimeStop stopObject(state, startMs + optimiseForMs);
+    
+    std::unique_ptr<FourVoiceTexture> model(new FourVoiceTexture(pieceParams));
+    std::unique_ptr<FourVoiceTexture> best;
+    std::vector<CostSample> trajectory;
+    double firstSolutionMs = 0.0;
+    
+    Gecode::Search::Options opts;
+    opts.threads = getPortfolioSize();  // BAB parallèle de Gecode plutôt qu'un portfolio
+    opts.stop = &stopObject;
+    
+    Gecode::BAB<FourVoiceTexture> engine(model.get(), opts);
+    
+    // Chaque solution de BAB est strictement meilleure que la précédente
+    while (auto* solution = engine.next())
+    {
+        const double nowMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+        if (best == nullptr)
+            firstSolutionMs = nowMs;
+        
+        best.reset(solution);
+        trajectory.push_back({ nowMs, extractCost(solution) });
+        stopObject.hasSolution.store(true);
+    }
+    
+    {
+        const juce::ScopedLock lock(resultLock);
+        lastResult.portfolioSize = opts.threads;
+        lastResult.optimised = best != nullptr;
+        lastResult.timeToFirstSolutionMs = firstSolutionMs;
+        lastResult.costTrajectory = std::move(trajectory);
+        lastResult.budgetExhausted = best == nullptr && state.budgetExhausted.load();
+        accumulate(lastResult.stats, engine.statistics());
+    }
+    
+    return best.release();
+}
+
+bool GenerationService::generateMidiFromPiece(const PieceSnapshot& piece, const juce::String& outputPath) {
     inputValidationError = false;  // Reset à chaque génération
     
     if (!ready) {
@@ -158,12 +775,9 @@ bool GenerationService::generateMidiFromPiece(const Piece& piece, const juce::St
     // Validation : chaque progression doit avoir au moins 2 accords
     // Justification : les contraintes harmoniques de Diatony (cadences V-I, voice leading)
     // nécessitent des transitions entre accords, donc minimum 2 par progression.
-    for (size_t i = 0; i < piece.getSectionCount(); ++i)
+    for (const auto& section : piece.getSections())
     {
-        auto section = piece.getSection(static_cast<int>(i));
-        int chordCount = static_cast<int>(section.getProgression().size());
-        
-        if (chordCount < 2)
+        if (section.chordCount < 2)
         {
             inputValidationError = true;
             lastError = "One of the progressions in the piece is invalid.\n\nEach progression requires at least 2 chords for harmonic constraints to apply.";
@@ -172,53 +786,48 @@ bool GenerationService::generateMidiFromPiece(const Piece& piece, const juce::St
     }
     
     try {
+        const double paramsStartMs = juce::Time::getMillisecondCounterHiRes();
+        // Les unique_ptr possèdent les paramètres (libérés sur tout chemin de sortie, exceptions comprises) ;
+        // Diatony ne reçoit que des vecteurs de pointeurs bruts
+        std::vector<std::unique_ptr<TonalProgressionParameters>> sectionParamsOwners;
         vector<TonalProgressionParameters*> sectionParamsList;
-        int cumulativeChordIndex = 0;
-        int totalChords = static_cast<int>(piece.getTotalChordCount());
+        int totalChords = piece.getTotalChordCount();
+        
+        // Problème canonique : tout ce que reçoit le solveur, qualités Auto déjà résolues
+        SolutionCache::KeyBuilder problemKey;
+        problemKey.add(totalChords);
+        problemKey.add(piece.getSectionCount());
         
-        for (size_t i = 0; i < piece.getSectionCount(); ++i)
+        // Clés par section et par modulation : servent à repérer ce qui a changé depuis la dernière solution
+        std::vector<SolutionCache::ProblemKey> sectionKeys(static_cast<size_t>(piece.getSectionCount()));
+        std::unordered_map<int, SolutionCache::ProblemKey> modulationKeys;
+        
+        for (int i = 0; i < piece.getSectionCount(); ++i)
         {
-            auto section = piece.getSection(static_cast<int>(i));
-            int sectionChordCount = static_cast<int>(section.getProgression().size());
-            
-            int startChordIndex = cumulativeChordIndex;
-            int endChordIndex = cumulativeChordIndex + sectionChordCount - 1;
-            
-            auto sectionParams = createSectionParams(
-                section,
-                static_cast<int>(i),
-                startChordIndex,
-                endChordIndex
-            );
-            
-            sectionParamsList.push_back(sectionParams);
-            cumulativeChordIndex += sectionChordCount;
+            sectionParamsOwners.push_back(createSectionParams(piece, i, problemKey, sectionKeys[static_cast<size_t>(i)]));
+            sectionParamsList.push_back(sectionParamsOwners.back().get());
         }
         
+        std::vector<std::unique_ptr<ModulationParameters>> modulationOwners;
         vector<ModulationParameters*> modulations;
         
-        for (size_t i = 0; i < piece.getModulationCount(); ++i)
+        for (const auto& modulationData : piece.getModulations())
         {
-            auto modulationModel = piece.getModulation(static_cast<int>(i));
-            auto [fromSection, toSection] = piece.getAdjacentSections(modulationModel);
-            
-            if (!fromSection.isValid() || !toSection.isValid())
-                continue;
-            
-            int fromSectionId = modulationModel.getFromSectionId();
-            int toSectionId = modulationModel.getToSectionId();
-            int fromSectionIndex = piece.getSectionIndexById(fromSectionId);
-            int toSectionIndex = piece.getSectionIndexById(toSectionId);
+            int fromSectionIndex = modulationData.fromSectionIndex;
+            int toSectionIndex = modulationData.toSectionIndex;
             
             if (fromSectionIndex < 0 || toSectionIndex < 0)
                 continue;
             
-            auto modulationType = modulationModel.getModulationType();
-            int fromChordIndex = modulationModel.getFromChordIndex();
-            int toChordIndex = modulationModel.getToChordIndex();
+            const auto& fromSection = piece.getSection(fromSectionIndex);
+            const auto& toSection = piece.getSection(toSectionIndex);
+            
+            auto modulationType = static_cast<Diatony::ModulationType>(modulationData.type);
+            int fromChordIndex = modulationData.fromChordIndex;
+            int toChordIndex = modulationData.toChordIndex;
             
-            int fromSectionSize = static_cast<int>(fromSection.getProgression().size());
-            int toSectionSize = static_cast<int>(toSection.getProgression().size());
+            int fromSectionSize = fromSection.chordCount;
+            int toSectionSize = toSection.chordCount;
             
             if (fromSectionSize == 0 || toSectionSize == 0)
                 continue;
@@ -276,80 +885,160 @@ bool GenerationService::generateMidiFromPiece(const Piece& piece, const juce::St
             else if (modulationType == Diatony::ModulationType::Alteration)
                 fromChordSectionRef = toSectionIndex;
             
-            // Calcul des indices globaux cumulatifs
-            int globalFromChordIndex = 0;
-            for (int j = 0; j < fromChordSectionRef; ++j)
-                globalFromChordIndex += static_cast<int>(piece.getSection(j).getProgression().size());
-            globalFromChordIndex += fromChordIndex;
+            // Indices globaux : décalages relevés sur l'index de la pièce à la création de l'instantané
+            int globalFromChordIndex = piece.getGlobalChordIndex(fromChordSectionRef, fromChordIndex);
+            int globalToChordIndex = piece.getGlobalChordIndex(toChordSectionRef, toChordIndex);
             
-            int globalToChordIndex = 0;
-            for (int j = 0; j < toChordSectionRef; ++j)
-                globalToChordIndex += static_cast<int>(piece.getSection(j).getProgression().size());
-            globalToChordIndex += toChordIndex;
-            
-            auto modulation = new ModulationParameters(
-                static_cast<int>(modulationModel.getModulationType()),
+            modulationOwners.emplace_back(new ModulationParameters(
+                modulationData.type,
                 globalFromChordIndex,
                 globalToChordIndex,
                 sectionParamsList[fromSectionIndex],
                 sectionParamsList[toSectionIndex]
-            );
+            ));
+            
+            modulations.push_back(modulationOwners.back().get());
+            
+            problemKey.add(modulationData.type);
+            problemKey.add(fromSectionIndex);
+            problemKey.add(toSectionIndex);
+            problemKey.add(globalFromChordIndex);
+            problemKey.add(globalToChordIndex);
             
-            modulations.push_back(modulation);
+            SolutionCache::KeyBuilder modulationKey;
+            modulationKey.add(modulationData.type);
+            modulationKey.add(fromSection.id);
+            modulationKey.add(toSection.id);
+            modulationKey.add(fromChordIndex);
+            modulationKey.add(toChordIndex);
+            modulationKeys[modulationData.id] = modulationKey.finish();
         }
         
-        auto pieceParams = new FourVoiceTextureParameters(
-            totalChords,
-            static_cast<int>(piece.getSectionCount()),
-            sectionParamsList,
-            modulations
-        );
+        problemKey.add(static_cast<int>(modulations.size()));
         
-        // Préparer le chemin de sauvegarde dans Application Support
-        juce::File appSupportDir = juce::File::getSpecialLocation(juce::File::userHomeDirectory)
-            .getChildFile(APPLICATION_SUPPORT_PATH)
-            .getChildFile("DiatonyDawApplication")
-            .getChildFile("Solutions")
-            .getChildFile("MidiFiles");
+        const int optimiseForMs = budgetForRequest.optimiseForMs;
         
-        if (!appSupportDir.exists())
-            appSupportDir.createDirectory();
+        // Préparer le chemin de sauvegarde dans Application Support
+        juce::File appSupportDir = FileUtils::getMidiSolutionsFolder();
         
         auto now = juce::Time::getCurrentTime();
         juce::String timestamp = now.formatted("%Y%m%d_%H%M%S");
         juce::String fileName = "diatony_piece_" + timestamp + ".mid";
-        juce::File midiFile = appSupportDir.getChildFile(fileName);
+        juce::File midiFile = outputPath.isNotEmpty() ? juce::File(outputPath)
+                                                      : appSupportDir.getChildFile(fileName);
         juce::String finalPath = midiFile.getFullPathName();
         lastGeneratedMidiPath = finalPath;
         
-        // Résolution avec Diatony
-        auto solution = solve_diatony(pieceParams, nullptr, false);
+        const double solveStartMs = juce::Time::getMillisecondCounterHiRes();
         
-        if (solution == nullptr) {
-            lastError = "No solution found by Diatony solver";
-            delete pieceParams;
-            for (auto* sp : sectionParamsList) delete sp;
-            for (auto* m : modulations) delete m;
-            return false;
+        {
+            const juce::ScopedLock lock(resultLock);
+            lastResult.stats.paramsMs = solveStartMs - paramsStartMs;
         }
         
-        // Génération du fichier MIDI
-        try {
-            writeSolToMIDIFile(totalChords, finalPath.toStdString(), solution);
-        } catch (const std::exception& e) {
-            lastError = juce::String("Error writing MIDI file: ") + e.what();
-            delete pieceParams;
-            for (auto* sp : sectionParamsList) delete sp;
-            for (auto* m : modulations) delete m;
-            return false;
+        // Cache : un problème déjà résolu passe directement à l'écriture MIDI.
+        // Pas en mode anytime : la qualité dépend de l'échéance et la trajectoire de coût doit être produite
+        const auto key = problemKey.finish();
+        std::vector<int> voicing;
+        const bool useCache = cacheEnabled.load() && optimiseForMs <= 0;
+        const bool cacheHit = useCache && solutionCache->lookup(key, voicing);
+        
+        {
+            const juce::ScopedLock lock(resultLock);
+            lastResult.fromCache = cacheHit;
         }
         
-        // Cleanup
-        delete pieceParams;
-        for (auto* sp : sectionParamsList) delete sp;
-        for (auto* m : modulations) delete m;
+        if (!cacheHit)
+        {
+            std::unique_ptr<FourVoiceTextureParameters> pieceParams(new FourVoiceTextureParameters(
+                totalChords,
+                piece.getSectionCount(),
+                sectionParamsList,
+                modulations
+            ));
+            
+            // Incrémental : les sections inchangées gardent leur voicing, seule la zone modifiée est cherchée
+            // (pas en mode anytime : toute la pièce doit pouvoir être améliorée)
+            std::vector<int> pinnedVoicing;
+            const int pinnedChords = incrementalEnabled.load() && optimiseForMs <= 0
+                ? computePinnedVoicing(piece, sectionKeys, modulationKeys, pinnedVoicing)
+                : 0;
+            
+            std::unique_ptr<FourVoiceTexture> solution;
+            
+            if (optimiseForMs > 0)
+            {
+                solution.reset(solveAnytime(pieceParams.get(), optimiseForMs));
+            }
+            else if (pinnedChords > 0)
+            {
+                solution.reset(solvePortfolio(pieceParams.get(), &pinnedVoicing));
+                
+                if (solution != nullptr)
+                {
+                    const juce::ScopedLock lock(resultLock);
+                    lastResult.pinnedChords = pinnedChords;
+                }
+                else if (!isCancellationRequested() && !getLastResult().budgetExhausted)
+                {
+                    // Les notes figées peuvent rendre le problème insatisfiable : repli sur la résolution complète
+                    solution.reset(solvePortfolio(pieceParams.get()));
+                }
+            }
+            else
+            {
+                // Résolution avec Diatony : N recherches diversifiées, la première solution gagne
+                solution.reset(solvePortfolio(pieceParams.get()));
+            }
+            
+            if (solution == nullptr) {
+                if (isCancellationRequested())
+                    lastError = "Generation cancelled";
+                else if (getLastResult().budgetExhausted)
+                    lastError = "\n\nThe search budget was exhausted before a solution was found.";
+                else
+                    lastError = "No solution found by Diatony solver";
+                return false;
+            }
+            
+            voicing = extractVoicing(solution.get());
+            
+            if (useCache)
+                solutionCache->store(key, voicing);
+        }
+        
+        rememberSolution(piece, sectionKeys, modulationKeys, voicing);
+        
+        const double writeStartMs = juce::Time::getMillisecondCounterHiRes();
+        
+        // Génération du fichier MIDI (même écriture pour une solution fraîche ou en cache)
+        juce::String writeError;
+        const bool written = VoicingMidiWriter::write(voicing, midiFile, writeError);
+        
+        {
+            const juce::ScopedLock lock(resultLock);
+            lastResult.stats.solveMs = writeStartMs - solveStartMs;
+            lastResult.stats.midiWriteMs = juce::Time::getMillisecondCounterHiRes() - writeStartMs;
+        }
+        
+        if (!written) {
+            lastError = "Error writing MIDI file: " + writeError;
+            return false;
+        }
         
         lastError.clear();
+        
+        // Énumération : la 1re solution part tout de suite, les suivantes sont streamées au fil de l'eau
+        const int requestedSolutions = getEnumerationCount();
+        if (requestedSolutions > 1)
+        {
+            deliverResult(true);
+            
+            std::unique_ptr<FourVoiceTextureParameters> enumerationParams(new FourVoiceTextureParameters(
+                totalChords, piece.getSectionCount(), sectionParamsList, modulations));
+            enumerateAlternatives(enumerationParams.get(), voicing, requestedSolutions, midiFile);
+        }
+        
         return true;
         
     } catch (const std::exception& e) {
@@ -370,48 +1059,257 @@ void GenerationService::reset()
     ready = true;
 }
 
-Tonality* GenerationService::createTonalityFromSection(const Section& section)
+Tonality* GenerationService::createTonalityFromSection(const PieceSnapshot::SectionData& section)
 {
-    int tonic = static_cast<int>(section.getNote());
-    return section.getIsMajor() ? static_cast<Tonality*>(new MajorTonality(tonic))
-                                : static_cast<Tonality*>(new MinorTonality(tonic));
+    return section.isMajor ? static_cast<Tonality*>(new MajorTonality(section.tonic))
+                           : static_cast<Tonality*>(new MinorTonality(section.tonic));
 }
 
-GenerationService::ChordVectors GenerationService::extractChordVectors(const Progression& progression, Tonality* tonality)
+GenerationService::ChordVectors GenerationService::extractChordVectors(const PieceSnapshot& snapshot, int sectionIndex, Tonality* tonality)
 {
     ChordVectors result;
+    const auto& section = snapshot.getSection(sectionIndex);
+    
+    result.degrees.reserve(static_cast<size_t>(section.chordCount));
+    result.qualities.reserve(static_cast<size_t>(section.chordCount));
+    result.states.reserve(static_cast<size_t>(section.chordCount));
     
-    for (size_t i = 0; i < progression.size(); ++i) {
-        auto chord = progression.getChord(i);
-        int degree = static_cast<int>(chord.getDegree());
+    for (int i = 0; i < section.chordCount; ++i) {
+        const auto& chord = snapshot.getChord(section.firstChordIndex + i);
         
-        result.degrees.push_back(degree);
-        result.states.push_back(static_cast<int>(chord.getChordState()));
+        result.degrees.push_back(chord.degree);
+        result.states.push_back(chord.state);
         
-        auto quality = chord.getQuality();
-        if (quality == Diatony::ChordQuality::Auto)
-            result.qualities.push_back(tonality->get_chord_quality(degree));
+        if (chord.quality == static_cast<int>(Diatony::ChordQuality::Auto))
+            result.qualities.push_back(tonality->get_chord_quality(chord.degree));
         else
-            result.qualities.push_back(static_cast<int>(quality));
+            result.qualities.push_back(chord.quality);
     }
     
     return result;
 }
 
-TonalProgressionParameters* GenerationService::createSectionParams(
-    const Section& section, int sectionIndex, int startChordIndex, int endChordIndex)
+std::unique_ptr<TonalProgressionParameters> GenerationService::createSectionParams(const PieceSnapshot& snapshot, int sectionIndex,
+                                                                                   SolutionCache::KeyBuilder& problemKey,
+                                                                                   SolutionCache::ProblemKey& sectionKey)
 {
-    Tonality* tonality = createTonalityFromSection(section);
-    auto progression = section.getProgression();
-    auto chordVectors = extractChordVectors(progression, tonality);
-    int numberOfChords = static_cast<int>(progression.size());
+    const auto& section = snapshot.getSection(sectionIndex);
+    std::unique_ptr<Tonality> tonality(createTonalityFromSection(section));
+    auto chordVectors = extractChordVectors(snapshot, sectionIndex, tonality.get());
+    
+    int startChordIndex = section.firstChordIndex;
+    int endChordIndex = section.firstChordIndex + section.chordCount - 1;
+    
+    problemKey.add(section.tonic);
+    problemKey.add(section.isMajor);
+    problemKey.add(startChordIndex);
+    problemKey.add(endChordIndex);
+    problemKey.add(chordVectors.degrees);
+    problemKey.add(chordVectors.qualities);
+    problemKey.add(chordVectors.states);
+    
+    // Contenu seul (sans position globale) : une section inchangée garde sa clé si une autre grandit
+    SolutionCache::KeyBuilder sectionBuilder;
+    sectionBuilder.add(section.tonic);
+    sectionBuilder.add(section.isMajor);
+    sectionBuilder.add(chordVectors.degrees);
+    sectionBuilder.add(chordVectors.qualities);
+    sectionBuilder.add(chordVectors.states);
+    sectionKey = sectionBuilder.finish();
     
-    return new TonalProgressionParameters(
-        sectionIndex, numberOfChords, startChordIndex, endChordIndex,
-        tonality, chordVectors.degrees, chordVectors.qualities, chordVectors.states
-    );
+    // La tonalité passe aux paramètres de la section, comme avant
+    return std::unique_ptr<TonalProgressionParameters>(new TonalProgressionParameters(
+        sectionIndex, section.chordCount, startChordIndex, endChordIndex,
+        tonality.release(), chordVectors.degrees, chordVectors.qualities, chordVectors.states
+    ));
 }
 
+int GenerationService::computePinnedVoicing(const PieceSnapshot& piece,
+                                            const std::vector<SolutionCache::ProblemKey>& sectionKeys,
+                                            const std::unordered_map<int, SolutionCache::ProblemKey>& modulationKeys,
+                                            std::vector<int>& pinnedVoicing) const
+{
+    constexpr int voicesPerChord = VoicingMidiWriter::voicesPerChord;
+    
+    if (previousSolution.voicing.empty())
+        return 0;
+    
+    const int sectionCount = piece.getSectionCount();
+    std::vector<bool> clean(static_cast<size_t>(sectionCount), false);
+    
+    for (int i = 0; i < sectionCount; ++i)
+    {
+        const auto& section = piece.getSection(i);
+        auto it = previousSolution.sectionsById.find(section.id);
+        clean[static_cast<size_t>(i)] = it != previousSolution.sectionsById.end()
+                                        && it->second.key == sectionKeys[static_cast<size_t>(i)];
+    }
+    
+    // Une modulation nouvelle ou modifiée salit ses deux sections
+    for (const auto& modulation : piece.getModulations())
+    {
+        if (modulation.fromSectionIndex < 0 || modulation.toSectionIndex < 0)
+            continue;
+        
+        auto current = modulationKeys.find(modulation.id);
+        auto previous = previousSolution.modulationsById.find(modulation.id);
+        const bool unchanged = current != modulationKeys.end() && previous != previousSolution.modulationsById.end()
+                               && current->second == previous->second;
+        
+        if (!unchanged)
+        {
+            clean[static_cast<size_t>(modulation.fromSectionIndex)] = false;
+            clean[static_cast<size_t>(modulation.toSectionIndex)] = false;
+        }
+    }
+    
+    pinnedVoicing.assign(static_cast<size_t>(piece.getTotalChordCount() * voicesPerChord), -1);
+    int pinnedChords = 0;
+    
+    for (int i = 0; i < sectionCount; ++i)
+    {
+        if (!clean[static_cast<size_t>(i)])
+            continue;
+        
+        const auto& section = piece.getSection(i);
+        const auto& previous = previousSolution.sectionsById.at(section.id);
+        
+        // Accords frontières libres côté zone modifiée : le voice leading peut s'y raccorder
+        const bool freeFirst = i > 0 && !clean[static_cast<size_t>(i - 1)];
+        const bool freeLast = i < sectionCount - 1 && !clean[static_cast<size_t>(i + 1)];
+        
+        for (int c = 0; c < section.chordCount; ++c)
+        {
+            if ((c == 0 && freeFirst) || (c == section.chordCount - 1 && freeLast))
+                continue;
+            
+            const int from = (previous.firstChordIndex + c) * voicesPerChord;
+            const int to = (section.firstChordIndex + c) * voicesPerChord;
+            
+            for (int v = 0; v < voicesPerChord; ++v)
+                pinnedVoicing[static_cast<size_t>(to + v)] = previousSolution.voicing[static_cast<size_t>(from + v)];
+            
+            ++pinnedChords;
+        }
+    }
+    
+    return pinnedChords;
+}
+
+void GenerationService::rememberSolution(const PieceSnapshot& piece,
+                                         const std::vector<SolutionCache::ProblemKey>& sectionKeys,
+                                         const std::unordered_map<int, SolutionCache::ProblemKey>& modulationKeys,
+                                         const std::vector<int>& voicing)
+{
+    previousSolution.sectionsById.clear();
+    
+    for (int i = 0; i < piece.getSectionCount(); ++i)
+    {
+        const auto& section = piece.getSection(i);
+        previousSolution.sectionsById[section.id] = { sectionKeys[static_cast<size_t>(i)],
+                                                      section.firstChordIndex, section.chordCount };
+    }
+    
+    previousSolution.modulationsById = modulationKeys;
+    previousSolution.voicing = voicing;
+}
+
+void GenerationService::setEnumerationCount(int numSolutions)
+{
+    enumerationCount.store(juce::jlimit(1, maxEnumeratedSolutions, numSolutions));
+}
+
+int GenerationService::getEnumerationCount() const { return enumerationCount.load(); }
+bool GenerationService::popStreamedSolution(StreamedSolution& solution) { return solutionStream.pop(solution); }
+
+void GenerationService::setIncrementalEnabled(bool shouldBeEnabled) { incrementalEnabled.store(shouldBeEnabled); }
+bool GenerationService::isIncrementalEnabled() const { return incrementalEnabled.load(); }
+
+std::vector<int> GenerationService::extractVoicing(FourVoiceTexture* solution)
+{
+    // Seul point qui lit les variables de la solution Gecode (4 voix par accord, basse → soprano)
+    auto fullVoicing = solution->getFullVoicing();
+    
+    std::vector<int> voicing;
+    voicing.reserve(static_cast<size_t>(fullVoicing.size()));
+    for (int i = 0; i < fullVoicing.size(); ++i)
+        voicing.push_back(fullVoicing[i].val());
+    
+    return voicing;
+}
+
+std::vector<int> GenerationService::extractCost(FourVoiceTexture* solution)
+{
+    // FourVoiceTexture est un IntLexMinimizeSpace : cost() donne les coûts par ordre de priorité
+    auto costVars = solution->cost();
+    
+    std::vector<int> cost;
+    cost.reserve(static_cast<size_t>(costVars.size()));
+    for (int i = 0; i < costVars.size(); ++i)
+        cost.push_back(costVars[i].val());
+    
+    return cost;
+}
+
+//==============================================================================
+void GenerationStats::merge(const GenerationStats& other)
+{
+    nodes += other.nodes;
+    fails += other.fails;
+    restarts += other.restarts;
+    nogoods += other.nogoods;
+    propagations += other.propagations;
+    peakDepth = juce::jmax(peakDepth, other.peakDepth);
+    peakMemoryBytes = juce::jmax(peakMemoryBytes, other.peakMemoryBytes);
+    
+    paramsMs += other.paramsMs;
+    solveMs += other.solveMs;
+    midiWriteMs += other.midiWriteMs;
+    sidecarWriteMs += other.sidecarWriteMs;
+    totalMs += other.totalMs;
+}
+
+std::unique_ptr<juce::XmlElement> GenerationStats::createXml() const
+{
+    auto xml = std::make_unique<juce::XmlElement>(xmlTag);
+    xml->setAttribute("nodes", juce::String(nodes));
+    xml->setAttribute("fails", juce::String(fails));
+    xml->setAttribute("restarts", juce::String(restarts));
+    xml->setAttribute("nogoods", juce::String(nogoods));
+    xml->setAttribute("propagations", juce::String(propagations));
+    xml->setAttribute("peakDepth", peakDepth);
+    xml->setAttribute("peakMemoryBytes", juce::String(peakMemoryBytes));
+    xml->setAttribute("paramsMs", paramsMs);
+    xml->setAttribute("solveMs", solveMs);
+    xml->setAttribute("midiWriteMs", midiWriteMs);
+    xml->setAttribute("sidecarWriteMs", sidecarWriteMs);
+    xml->setAttribute("totalMs", totalMs);
+    return xml;
+}
+
+GenerationStats GenerationStats::fromXml(const juce::XmlElement& xml)
+{
+    GenerationStats stats;
+    stats.nodes = xml.getStringAttribute("nodes").getLargeIntValue();
+    stats.fails = xml.getStringAttribute("fails").getLargeIntValue();
+    stats.restarts = xml.getStringAttribute("restarts").getLargeIntValue();
+    stats.nogoods = xml.getStringAttribute("nogoods").getLargeIntValue();
+    stats.propagations = xml.getStringAttribute("propagations").getLargeIntValue();
+    stats.peakDepth = xml.getIntAttribute("peakDepth");
+    stats.peakMemoryBytes = xml.getStringAttribute("peakMemoryBytes").getLargeIntValue();
+    stats.paramsMs = xml.getDoubleAttribute("paramsMs");
+    stats.solveMs = xml.getDoubleAttribute("solveMs");
+    stats.midiWriteMs = xml.getDoubleAttribute("midiWriteMs");
+    stats.sidecarWriteMs = xml.getDoubleAttribute("sidecarWriteMs");
+    stats.totalMs = xml.getDoubleAttribute("totalMs");
+    return stats;
+}
+
+SolutionCache::Stats GenerationService::getCacheStats() const { return solutionCache->getStats(); }
+
+void GenerationService::setCacheEnabled(bool shouldBeEnabled) { cacheEnabled.store(shouldBeEnabled); }
+bool GenerationService::isCacheEnabled() const { return cacheEnabled.load(); }
+
 void GenerationService::logGenerationInfo(const Piece& piece)
 {
     std::cout << "=== PIECE INFO ===" << std::endl;
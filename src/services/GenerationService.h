@@ -3,24 +3,133 @@
 #include <juce_core/juce_core.h>
 #include <memory>
 #include <atomic>
+#include <unordered_map>
 #include "../model/Piece.h"
+#include "../model/PieceSnapshot.h"
+#include "SolutionCache.h"
+#include "SolutionStream.h"
 
 class AppController;
 
+/**
+ * @brief Budget d'une requête de génération (0 = illimité).
+ * Par défaut aucune limite : comme avant l'introduction du budget, une grande pièce est résolue
+ * jusqu'au bout (l'utilisateur peut toujours annuler). Le nombre de nœuds s'applique à chaque
+ * recherche du portfolio.
+ */
+struct GenerationBudget
+{
+    int timeLimitMs = 0;
+    unsigned long nodeLimit = 0;
+    
+    /**
+     * Mode anytime (> 0) : branch-and-bound sur les coûts de Diatony, la solution est améliorée
+     * jusqu'à cette échéance (comptée depuis le lancement) et la meilleure trouvée est retournée.
+     */
+    int optimiseForMs = 0;
+};
+
+/** @brief Point de la trajectoire de coût du mode anytime (coût lexicographique de Diatony). */
+struct CostSample
+{
+    double timeMs = 0.0;                    // Depuis le lancement de la recherche
+    std::vector<int> cost;
+};
+
+/**
+ * @brief Statistiques d'une génération : recherche Gecode (somme sur les workers) et temps par phase.
+ * Écrites dans le .diatony associé (élément GenerationStats, ignoré au chargement).
+ */
+struct GenerationStats
+{
+    juce::int64 nodes = 0;
+    juce::int64 fails = 0;
+    juce::int64 restarts = 0;
+    juce::int64 nogoods = 0;
+    juce::int64 propagations = 0;
+    int peakDepth = 0;
+    juce::int64 peakMemoryBytes = 0;        // Pic RSS du processus (getrusage)
+    
+    double paramsMs = 0.0;                  // Construction des paramètres Diatony
+    double solveMs = 0.0;                   // Cache + recherche
+    double midiWriteMs = 0.0;
+    double sidecarWriteMs = 0.0;            // Écriture du .diatony (message thread) ; non enregistrée dans ce fichier
+    double totalMs = 0.0;                   // Requête complète côté worker
+    
+    /** @brief Compteurs et temps de phase additionnés (nuls pour un worker), pics : maximum. */
+    void merge(const GenerationStats& other);
+    std::unique_ptr<juce::XmlElement> createXml() const;
+    static GenerationStats fromXml(const juce::XmlElement& xml);
+    
+    static constexpr const char* xmlTag = "GenerationStats";
+};
+
+/** @brief Résultat d'une génération, lu sur le message thread après le callback. */
+struct GenerationResult
+{
+    int jobId = 0;                          // Requête dont provient ce résultat
+    bool success = false;
+    juce::String midiPath;
+    juce::String error;
+    bool inputValidationError = false;      // Warning de validation plutôt qu'échec du solveur
+    
+    int portfolioSize = 1;                  // Nombre de recherches lancées en parallèle
+    int winningWorker = -1;                 // Index du worker ayant trouvé la solution (-1 si aucun)
+    double timeToFirstSolutionMs = 0.0;     // Temps mural entre le lancement du portfolio et la 1re solution
+    
+    bool cancelled = false;                 // Annulée via cancelGeneration()
+    bool budgetExhausted = false;           // Arrêtée par le budget temps/nœuds sans solution
+    bool fromCache = false;                 // Voicing servi par le SolutionCache, sans recherche
+    int pinnedChords = 0;                   // Accords repris de la solution précédente (re-résolution incrémentale)
+    
+    bool optimised = false;                 // Solution issue du mode anytime (branch-and-bound)
+    std::vector<CostSample> costTrajectory; // Une entrée par amélioration, dans l'ordre chronologique
+    
+    GenerationStats stats;
+    GenerationStats enumerationStats;       // Recherche des solutions alternatives (mode énumération)
+};
+
 /**
  * @brief Service de génération MIDI via le solveur Diatony (thread worker).
  *
  * Pattern Adapter : traduit notre modèle Piece vers la librairie Diatony.
  * Seul le .cpp inclut les headers Diatony (couplage faible).
+ *
+ * File de requêtes avec coalescence : une nouvelle requête remplace la requête en attente
+ * et annule celle en cours. Seul le résultat de la dernière requête est livré au contrôleur.
  */
 class GenerationService : public juce::Thread {
 public:
     GenerationService();
     ~GenerationService();
     
-    /** @brief Lance la génération asynchrone ; retourne false si déjà en cours. */
-    bool startGeneration(const Piece& piece, const juce::String& outputPath, AppController* controller);
+    /**
+     * @brief Met en file une génération sur un instantané de la pièce (message thread).
+     * Remplace toute requête plus ancienne ; retourne false seulement si le service n'est pas prêt.
+     * Pendant un generateNow(), la requête attend la fin de la résolution synchrone.
+     */
+    bool startGeneration(const Piece& piece, const juce::String& outputPath, AppController* controller,
+                         const GenerationBudget& budget = GenerationBudget());
+    
+    /**
+     * @brief Résout la pièce sur le thread appelant et retourne le résultat (outils headless, benchmark).
+     * Aucun contrôleur n'est notifié (même celui d'une requête précédente) ; échoue si une génération
+     * asynchrone est en cours.
+     */
+    GenerationResult generateNow(const Piece& piece, const juce::String& outputPath,
+                                 const GenerationBudget& budget = GenerationBudget());
     
+    /**
+     * @brief Annule la requête en cours et abandonne celle en attente (non bloquant).
+     * Le stop Gecode est interrogé à chaque nœud : la recherche s'interrompt en quelques ms.
+     */
+    void cancelGeneration();
+    bool isCancellationRequested() const;
+    
+    /** @brief Identifiant de la dernière requête acceptée (0 si aucune). */
+    int getLatestJobId() const;
+    
+    /** @brief true si une requête est en attente ou en cours de résolution. */
     bool isGenerating() const;
     bool isReady() const;
     juce::String getLastError() const;
@@ -32,14 +141,75 @@ public:
     
     bool getLastGenerationSuccess() const;
     juce::String getLastGeneratedMidiPath() const;
+    GenerationResult getLastResult() const;
+    
+    /**
+     * @brief Nombre de recherches Diatony concurrentes (stratégies diversifiées).
+     * La première solution trouvée est retenue, les autres recherches sont arrêtées.
+     */
+    void setPortfolioSize(int numWorkers);
+    int getPortfolioSize() const;
+    static int getDefaultPortfolioSize();
+    
+    /**
+     * @brief Re-résolution incrémentale (activée par défaut) : les sections inchangées depuis
+     * la dernière solution gardent leur voicing, seule la zone modifiée est recherchée.
+     */
+    void setIncrementalEnabled(bool shouldBeEnabled);
+    bool isIncrementalEnabled() const;
+    
+    /**
+     * @brief Nombre de solutions distinctes à énumérer (1 = solution unique, comportement par défaut).
+     * La première est livrée comme d'habitude ; les suivantes arrivent via popStreamedSolution()
+     * pendant que la recherche continue.
+     */
+    void setEnumerationCount(int numSolutions);
+    int getEnumerationCount() const;
+    static constexpr int maxEnumeratedSolutions = 16;
+    
+    /** @brief Consomme la prochaine solution énumérée (message thread uniquement). */
+    bool popStreamedSolution(StreamedSolution& solution);
+    
+    /** @brief Hits/misses du cache de solutions partagé par toutes les instances. */
+    SolutionCache::Stats getCacheStats() const;
+    
+    /** @brief Désactivé, chaque requête est résolue (benchmark) ; le cache partagé n'est ni lu ni enrichi. */
+    void setCacheEnabled(bool shouldBeEnabled);
+    bool isCacheEnabled() const;
 
 protected:
     void run() override;
 
 private:
+    friend class GenerationServiceTest;     // Inspecte previousSolution (re-résolution incrémentale)
+    
     struct Impl;
     std::unique_ptr<Impl> pImpl;
     
+    /** @brief Requête en file : possède son instantané immuable de la pièce. */
+    struct GenerationJob
+    {
+        int id = 0;
+        PieceSnapshot snapshot;
+        juce::String outputPath;
+        GenerationBudget budget;
+        bool synchronous = false;           // generateNow() : résultat retourné, aucun callback asynchrone
+    };
+    
+    /** @brief Résout une requête sur le thread worker et livre le résultat si elle est toujours la dernière. */
+    void processJob(GenerationJob& job);
+    
+    /** @brief Publie lastResult et notifie le contrôleur (une seule fois par requête, jamais pour generateNow). */
+    void deliverResult(bool success);
+    void notifyController();
+    bool isLatestJob(int jobId) const;
+    
+    /** @brief Recherche DFS des solutions suivantes, chacune écrite en MIDI puis poussée dans solutionStream. */
+    void enumerateAlternatives(class FourVoiceTextureParameters* pieceParams,
+                               const std::vector<int>& firstVoicing,
+                               int requestedCount,
+                               const juce::File& firstMidiFile);
+    
     void* createDiatonyParametersFromPiece(const Piece& piece);
     
     struct ChordVectors {
@@ -48,27 +218,98 @@ private:
         std::vector<int> states;
     };
     
-    /** @brief Crée Tonality* depuis Section. L'appelant doit delete. */
-    class Tonality* createTonalityFromSection(const Section& section);
+    /** @brief Crée Tonality* depuis une section de l'instantané. L'appelant doit delete. */
+    class Tonality* createTonalityFromSection(const PieceSnapshot::SectionData& section);
     
     /** @brief Extrait les vecteurs d'accords ; qualité Auto → tonality->get_chord_quality(). */
-    ChordVectors extractChordVectors(const Progression& progression, class Tonality* tonality);
+    ChordVectors extractChordVectors(const PieceSnapshot& snapshot, int sectionIndex, class Tonality* tonality);
     
-    /** @brief Crée TonalProgressionParameters*. L'appelant doit delete. */
-    class TonalProgressionParameters* createSectionParams(
-        const Section& section, int sectionIndex, int startChordIndex, int endChordIndex);
+    /**
+     * @brief Crée les TonalProgressionParameters de la section et l'ajoute à la clé du problème.
+     * sectionKey reçoit la clé du contenu de la section seule (détection des sections modifiées).
+     */
+    std::unique_ptr<class TonalProgressionParameters> createSectionParams(const PieceSnapshot& snapshot, int sectionIndex,
+                                                                        SolutionCache::KeyBuilder& problemKey,
+                                                                        SolutionCache::ProblemKey& sectionKey);
     
-    bool generateMidiFromPiece(const Piece& piece, const juce::String& outputPath);
+    /** @brief outputPath vide : fichier horodaté dans le dossier des solutions. */
+    bool generateMidiFromPiece(const PieceSnapshot& snapshot, const juce::String& outputPath);
+    
+    /** @brief Lance le portfolio et retourne la première solution (nullptr si aucune). L'appelant doit delete. */
+    class FourVoiceTexture* solvePortfolio(class FourVoiceTextureParameters* pieceParams,
+                                           const std::vector<int>* pinnedVoicing = nullptr);
+    
+    /** @brief Dernière solution livrée, par id de section/modulation (thread worker uniquement). */
+    struct PreviousSolution
+    {
+        struct SectionRecord
+        {
+            SolutionCache::ProblemKey key;
+            int firstChordIndex = 0;
+            int chordCount = 0;
+        };
+        
+        std::unordered_map<int, SectionRecord> sectionsById;
+        std::unordered_map<int, SolutionCache::ProblemKey> modulationsById;
+        std::vector<int> voicing;
+    };
+    
+    /** @brief Remplit pinnedVoicing (-1 = libre) depuis les sections inchangées ; retourne le nombre d'accords figés. */
+    int computePinnedVoicing(const PieceSnapshot& piece,
+                             const std::vector<SolutionCache::ProblemKey>& sectionKeys,
+                             const std::unordered_map<int, SolutionCache::ProblemKey>& modulationKeys,
+                             std::vector<int>& pinnedVoicing) const;
+    
+    void rememberSolution(const PieceSnapshot& piece,
+                          const std::vector<SolutionCache::ProblemKey>& sectionKeys,
+                          const std::unordered_map<int, SolutionCache::ProblemKey>& modulationKeys,
+                          const std::vector<int>& voicing);
+    
+    /** @brief Notes MIDI de la solution, 4 par accord (basse, ténor, alto, soprano). */
+    static std::vector<int> extractVoicing(class FourVoiceTexture* solution);
+    
+    /** @brief Valeurs des variables de coût de la solution (ordre lexicographique de Diatony). */
+    static std::vector<int> extractCost(class FourVoiceTexture* solution);
+    
+    /**
+     * @brief Branch-and-bound anytime : améliore jusqu'à l'échéance et retourne la meilleure solution.
+     * L'échéance ne s'applique qu'une fois une première solution trouvée ; le budget reste la borne dure.
+     */
+    class FourVoiceTexture* solveAnytime(class FourVoiceTextureParameters* pieceParams, int optimiseForMs);
     
     mutable juce::String lastError;
     mutable bool inputValidationError = false;  // Distingue warning (validation) vs error (solveur)
     bool ready;
     
     AppController* appController = nullptr;
-    const Piece* pieceToGenerate = nullptr;
-    juce::String outputPathToGenerate;
+    
+    std::unique_ptr<GenerationJob> pendingJob;  // Au plus une requête en attente (la plus récente)
+    int latestJobId = 0;
+    int runningJobId = 0;
+    bool synchronousJobRunning = false;         // generateNow() en cours : le worker diffère pendingJob
+    juce::CriticalSection queueLock;
+    juce::WaitableEvent jobAvailable;
     
     std::atomic<bool> generationSuccess { false };
     juce::String lastGeneratedMidiPath;
     juce::CriticalSection callbackLock;
+    
+    GenerationBudget budgetForRequest;
+    std::atomic<bool> cancelRequested { false };
+    
+    std::atomic<int> portfolioSize { getDefaultPortfolioSize() };
+    GenerationResult lastResult;
+    juce::CriticalSection resultLock;
+    
+    juce::SharedResourcePointer<SolutionCache> solutionCache;
+    
+    std::atomic<bool> cacheEnabled { true };
+    std::atomic<bool> incrementalEnabled { true };
+    std::atomic<int> enumerationCount { 1 };
+    SolutionStream solutionStream;
+    
+    int currentJobId = 0;           // Thread worker uniquement
+    bool currentJobSynchronous = false;
+    bool resultDelivered = false;
+    PreviousSolution previousSolution;
 }; 
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include "HistoryCatalogue.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace
+{
+    const juce::Identifier catalogueType { "HistoryCatalogue" };
+    const juce::Identifier entryType     { "Entry" };
+    const juce::Identifier versionProp   { "version" };
+    const juce::Identifier fileProp      { "file" };
+    const juce::Identifier nameProp      { "name" };
+    const juce::Identifier mtimeProp     { "mtime" };
+    const juce::Identifier sizeProp      { "size" };
+    const juce::Identifier keyProp       { "startKey" };
+    const juce::Identifier sectionsProp  { "sections" };
+    const juce::Identifier modulationsProp { "modulations" };
+    const juce::Identifier chordsProp    { "chords" };
+    const juce::Identifier noteProp      { "note" };
+    const juce::Identifier majorProp     { "major" };
+    const juce::Identifier modTypesProp  { "modulationTypes" };
+    const juce::Identifier degreesProp   { "degrees" };
+}
+
+HistoryCatalogue::HistoryCatalogue(const juce::File& solutionsDirectory, const juce::File& catalogueFile)
+    : directory(solutionsDirectory), indexFile(catalogueFile)
+{
+}
+
+bool HistoryCatalogue::refresh()
+{
+    bool changed = false;
+    auto outcome = scan(directory, getStamps(), nullptr,
+                        [this, &changed](std::vector<HistoryItem> batch) { changed |= mergeBatch(std::move(batch)); });
+
+    changed |= finishScan(outcome);
+    return changed;
+}
+
+HistoryCatalogue::StampMap HistoryCatalogue::getStamps()
+{
+    loadIndex();
+
+    StampMap stamps;
+    stamps.reserve(items.size());
+    for (const auto& item : items)
+        stamps[item.diatonyFile.getFileName()] = { item.timestamp, item.fileSize };
+    return stamps;
+}
+
+HistoryCatalogue::ScanOutcome HistoryCatalogue::scan(const juce::File& solutionsDirectory, const StampMap& known,
+                                                     const std::function<bool()>& shouldCancel,
+                                                     const BatchCallback& onBatch, int batchSize)
+{
+    ScanOutcome outcome;
+    if (!solutionsDirectory.isDirectory())
+        return outcome;
+
+    struct Candidate
+    {
+        juce::File file;
+        juce::Time modificationTime;
+        juce::int64 size;
+    };
+
+    // L'itérateur fournit date et taille sans stat supplémentaire
+    std::vector<Candidate> candidates;
+    for (const auto& entry : juce::RangedDirectoryIterator(solutionsDirectory, false, "*.diatony", juce::File::findFiles))
+        candidates.push_back({ entry.getFile(), entry.getModificationTime(), entry.getFileSize() });
+
+    // Plus récents d'abord : ce sont eux que la liste affiche en tête
+    std::sort(candidates.begin(), candidates.end(),
+        [](const Candidate& a, const Candidate& b) { return a.modificationTime > b.modificationTime; });
+
+    std::vector<HistoryItem> batch;
+    const auto flush = [&]
+    {
+        if (!batch.empty() && onBatch)
+            onBatch(std::move(batch));
+        batch.clear();
+    };
+
+    for (const auto& candidate : candidates)
+    {
+        if (shouldCancel && shouldCancel())
+        {
+            outcome.cancelled = true;
+            break;
+        }
+
+        outcome.presentFiles.add(candidate.file.getFileName());
+
+        // Comparaison à la milliseconde près : certains systèmes de fichiers arrondissent
+        auto stamp = known.find(candidate.file.getFileName());
+        if (stamp != known.end() && stamp->second.size == candidate.size
+            && stamp->second.modificationTime.toMilliseconds() == candidate.modificationTime.toMilliseconds())
+            continue;
+
+        HistoryItem item;
+        ++outcome.numParsed;
+        if (parseDiatonyFile(candidate.file, item))
+            batch.push_back(std::move(item));
+
+        if (static_cast<int>(batch.size()) >= batchSize)
+            flush();
+    }
+
+    flush();
+    return outcome;
+}
+
+bool HistoryCatalogue::mergeBatch(std::vector<HistoryItem> batch)
+{
+    if (batch.empty())
+        return false;
+
+    loadIndex();
+
+    for (auto& item : batch)
+    {
+        auto row = rowByFileName.find(item.diatonyFile.getFileName());
+        if (row != rowByFileName.end())
+        {
+            items[row->second] = std::move(item);
+        }
+        else
+        {
+            rowByFileName[item.diatonyFile.getFileName()] = items.size();
+            items.push_back(std::move(item));
+        }
+    }
+
+    sortAndReindex();
+    indexDirty = true;
+    return true;
+}
+
+bool HistoryCatalogue::finishScan(const ScanOutcome& outcome)
+{
+    loadIndex();
+    numParsedFiles += outcome.numParsed;
+
+    // Un scan interrompu n'a pas vu tout le dossier : rien n'est retiré
+    bool removed = false;
+    if (!outcome.cancelled)
+    {
+        // Recherche en O(1) par entrée : StringArray::contains est linéaire
+        const std::unordered_set<juce::String> present(outcome.presentFiles.begin(), outcome.presentFiles.end());
+
+        const auto sizeBefore = items.size();
+        items.erase(std::remove_if(items.begin(), items.end(),
+                                   [&present](const HistoryItem& item)
+                                   {
+                                       return present.count(item.diatonyFile.getFileName()) == 0
+                                           && !item.diatonyFile.existsAsFile();
+                                   }),
+                    items.end());
+        removed = items.size() != sizeBefore;
+
+        if (removed)
+            sortAndReindex();
+    }
+
+    if (removed || indexDirty)
+    {
+        saveIndex();
+        indexDirty = false;
+    }
+
+    return removed;
+}
+
+bool HistoryCatalogue::addOrUpdate(const juce::File& diatonyFile)
+{
+    loadIndex();
+
+    if (!diatonyFile.isAChildOf(directory) || !diatonyFile.existsAsFile())
+        return false;
+
+    // Déjà indexé à l'identique (ex. génération vue à la fois par l'état et par la surveillance)
+    auto row = rowByFileName.find(diatonyFile.getFileName());
+    if (row != rowByFileName.end())
+    {
+        const auto& known = items[row->second];
+        if (known.fileSize == diatonyFile.getSize()
+            && known.timestamp.toMilliseconds() == diatonyFile.getLastModificationTime().toMilliseconds())
+            return false;
+    }
+
+    HistoryItem item;
+    if (!parseAndCount(diatonyFile, item))
+        return false;
+
+    if (row != rowByFileName.end())
+        items[row->second] = std::move(item);
+    else
+        items.push_back(std::move(item));
+
+    sortAndReindex();
+    saveIndex();
+    return true;
+}
+
+bool HistoryCatalogue::remove(const juce::File& diatonyFile)
+{
+    loadIndex();
+
+    auto row = rowByFileName.find(diatonyFile.getFileName());
+    if (row == rowByFileName.end())
+        return false;
+
+    items.erase(items.begin() + static_cast<std::ptrdiff_t>(row->second));
+    sortAndReindex();
+    saveIndex();
+    return true;
+}
+
+bool HistoryCatalogue::parseAndCount(const juce::File& file, HistoryItem& outItem)
+{
+    ++numParsedFiles;
+    return parseDiatonyFile(file, outItem);
+}
+
+bool HistoryCatalogue::parseDiatonyFile(const juce::File& file, HistoryItem& outItem)
+{
+    PieceFile::Summary summary;
+    if (!PieceFile::readSummary(file, summary))
+        return false;
+
+    outItem.diatonyFile = file;
+    outItem.midiFile = file.withFileExtension("mid");
+    outItem.name = file.getFileNameWithoutExtension();
+    outItem.timestamp = file.getLastModificationTime();
+    outItem.fileSize = file.getSize();
+    outItem.startNote = summary.startNote;
+    outItem.startIsMajor = summary.startIsMajor;
+    outItem.startKey = summary.startNote >= 0 ? noteToKeyLabel(summary.startNote, summary.startIsMajor) : "?";
+    outItem.numSections = summary.numSections;
+    outItem.numModulations = summary.numModulations;
+    outItem.numChords = summary.numChords;
+    outItem.modulationTypeMask = summary.modulationTypeMask;
+    outItem.chordDegrees = std::move(summary.chordDegrees);
+    return true;
+}
+
+juce::String HistoryCatalogue::noteToKeyLabel(int noteIndex, bool isMajor)
+{
+    static const char* noteNames[] = { "C", "C#", "D", "Eb", "E", "F", "F#", "G", "Ab", "A", "Bb", "B" };
+
+    if (noteIndex < 0 || noteIndex > 11)
+        return "?";
+
+    juce::String label = noteNames[noteIndex];
+    label += isMajor ? "" : "m";
+    return label;
+}
+
+//==============================================================================
+void HistoryCatalogue::loadIndex()
+{
+    if (indexLoaded)
+        return;
+
+    indexLoaded = true;
+    items.clear();
+
+    juce::FileInputStream in(indexFile);
+    if (!in.openedOk())
+        return;
+
+    auto tree = juce::ValueTree::readFromStream(in);
+
+    // Index d'une autre version : ignoré, reconstruit au prochain refresh()
+    if (!tree.hasType(catalogueType) || static_cast<int>(tree.getProperty(versionProp, 0)) != formatVersion)
+        return;
+
+    items.reserve(static_cast<size_t>(tree.getNumChildren()));
+    for (const auto& entry : tree)
+    {
+        HistoryItem item;
+        item.diatonyFile = directory.getChildFile(entry.getProperty(fileProp).toString());
+        item.midiFile = item.diatonyFile.withFileExtension("mid");
+        item.name = entry.getProperty(nameProp).toString();
+        item.timestamp = juce::Time(static_cast<juce::int64>(entry.getProperty(mtimeProp, 0)));
+        item.fileSize = static_cast<juce::int64>(entry.getProperty(sizeProp, 0));
+        item.startKey = entry.getProperty(keyProp, "?").toString();
+        item.numSections = entry.getProperty(sectionsProp, 0);
+        item.numModulations = entry.getProperty(modulationsProp, 0);
+        item.numChords = entry.getProperty(chordsProp, 0);
+        item.startNote = entry.getProperty(noteProp, -1);
+        item.startIsMajor = entry.getProperty(majorProp, true);
+        item.modulationTypeMask = entry.getProperty(modTypesProp, 0);
+        if (auto* degrees = entry.getProperty(degreesProp).getBinaryData())
+            item.chordDegrees = *degrees;
+        items.push_back(std::move(item));
+    }
+
+    sortAndReindex();
+}
+
+bool HistoryCatalogue::saveIndex() const
+{
+    juce::ValueTree tree(catalogueType);
+    tree.setProperty(versionProp, formatVersion, nullptr);
+
+    for (const auto& item : items)
+    {
+        juce::ValueTree entry(entryType);
+        entry.setProperty(fileProp, item.diatonyFile.getFileName(), nullptr);
+        entry.setProperty(nameProp, item.name, nullptr);
+        entry.setProperty(mtimeProp, item.timestamp.toMilliseconds(), nullptr);
+        entry.setProperty(sizeProp, item.fileSize, nullptr);
+        entry.setProperty(keyProp, item.startKey, nullptr);
+        entry.setProperty(sectionsProp, item.numSections, nullptr);
+        entry.setProperty(modulationsProp, item.numModulations, nullptr);
+        entry.setProperty(chordsProp, item.numChords, nullptr);
+        entry.setProperty(noteProp, item.startNote, nullptr);
+        entry.setProperty(majorProp, item.startIsMajor, nullptr);
+        entry.setProperty(modTypesProp, item.modulationTypeMask, nullptr);
+        entry.setProperty(degreesProp, item.chordDegrees, nullptr);
+        tree.appendChild(entry, nullptr);
+    }
+
+    // Écriture dans un fichier temporaire puis remplacement : un index n'est jamais à moitié écrit
+    juce::TemporaryFile temp(indexFile);
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk())
+            return false;
+        tree.writeToStream(out);
+    }
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+void HistoryCatalogue::sortAndReindex()
+{
+    std::sort(items.begin(), items.end(),
+        [](const HistoryItem& a, const HistoryItem& b) { return a.timestamp > b.timestamp; });
+
+    rowByFileName.clear();
+    rowByFileName.reserve(items.size());
+    for (size_t i = 0; i < items.size(); ++i)
+        rowByFileName[items[i].diatonyFile.getFileName()] = i;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+#include <functional>
+#include "../model/PieceFile.h"
+#include <unordered_map>
+#include <vector>
+
+/** @brief Métadonnées d'une solution générée (pour drag & drop). */
+struct HistoryItem
+{
+    juce::File diatonyFile;    // Fichier .diatony source (voir PieceFile)
+    juce::File midiFile;       // Fichier .mid associé (même nom, extension différente)
+    juce::String name;
+    juce::Time timestamp;
+    juce::String startKey;
+    int startNote = -1;        // Tonalité de la première section (0-11, -1 si inconnue)
+    bool startIsMajor = true;
+    int numSections = 0;
+    int numModulations = 0;
+    int numChords = 0;
+    int modulationTypeMask = 0;            // Bit i : au moins une modulation de type Diatony::ModulationType i
+    juce::MemoryBlock chordDegrees;        // Degrés (Diatony::ChordDegree) de chaque accord, sections séparées par sectionBreak
+    juce::int64 fileSize = 0;  // Taille et date (timestamp) du .diatony lors de l'analyse
+
+    static constexpr juce::uint8 sectionBreak = PieceFile::sectionBreak;
+};
+
+/**
+ * @brief Catalogue persistant de l'historique des solutions (.diatony d'un dossier).
+ *
+ * Les métadonnées sont gardées dans un index binaire (ValueTree::writeToStream) à côté des fichiers.
+ * refresh() liste le dossier et ne ré-analyse que les fichiers nouveaux ou dont la date/taille
+ * a changé ; addOrUpdate() insère directement le fichier qu'une génération vient d'écrire.
+ * Les éléments sont triés du plus récent au plus ancien.
+ *
+ * scan() ne touche à aucun état partagé : il peut tourner sur un thread de fond et livrer les
+ * entrées par lots (plus récentes d'abord), que le thread message applique via mergeBatch()
+ * puis finishScan(). refresh() enchaîne ces étapes de façon synchrone.
+ */
+class HistoryCatalogue
+{
+public:
+    /** @brief Date et taille d'un fichier lors de sa dernière analyse. */
+    struct FileStamp
+    {
+        juce::Time modificationTime;
+        juce::int64 size = 0;
+    };
+    using StampMap = std::unordered_map<juce::String, FileStamp>;
+
+    /** @brief Bilan d'un scan : fichiers présents dans le dossier et analyses effectuées. */
+    struct ScanOutcome
+    {
+        juce::StringArray presentFiles;
+        int numParsed = 0;
+        bool cancelled = false;
+    };
+
+    using BatchCallback = std::function<void(std::vector<HistoryItem>)>;
+
+    HistoryCatalogue(const juce::File& solutionsDirectory, const juce::File& catalogueFile);
+
+    /** @brief Synchronise avec le dossier ; true si le contenu a changé. */
+    bool refresh();
+
+    /** @brief Charge l'index si besoin et renvoie date/taille connues, par nom de fichier. */
+    StampMap getStamps();
+
+    /**
+     * @brief Liste le dossier et analyse les fichiers absents de known ou modifiés.
+     * Les entrées sont livrées du plus récent au plus ancien, par lots de batchSize.
+     * shouldCancel (optionnel) est consulté avant chaque analyse.
+     */
+    static ScanOutcome scan(const juce::File& solutionsDirectory, const StampMap& known,
+                            const std::function<bool()>& shouldCancel,
+                            const BatchCallback& onBatch, int batchSize = defaultBatchSize);
+
+    /** @brief Insère ou remplace les entrées d'un lot ; true si la liste a changé. */
+    bool mergeBatch(std::vector<HistoryItem> batch);
+
+    /** @brief Retire les fichiers disparus (scan complet uniquement) et sauvegarde l'index.
+     *  Un fichier absent du listing mais présent sur disque (ajouté depuis) est conservé. */
+    bool finishScan(const ScanOutcome& outcome);
+
+    /** @brief Ajoute ou remet à jour une seule entrée (false si illisible ou inchangée). */
+    bool addOrUpdate(const juce::File& diatonyFile);
+
+    /** @brief Retire l'entrée d'un fichier supprimé ; false si elle n'était pas indexée. */
+    bool remove(const juce::File& diatonyFile);
+
+    const std::vector<HistoryItem>& getItems() const { return items; }
+    const juce::File& getDirectory() const { return directory; }
+    int getNumParsedFiles() const { return numParsedFiles; }   // Fichiers lus (diagnostic)
+
+    /** @brief Lit les métadonnées d'un .diatony (en-tête seul si binaire, XML sinon). */
+    static bool parseDiatonyFile(const juce::File& file, HistoryItem& outItem);
+    static juce::String noteToKeyLabel(int noteIndex, bool isMajor);
+
+    static constexpr int formatVersion = 2;   // 2 : tonalité, types de modulation et degrés
+    static constexpr int defaultBatchSize = 16;
+
+private:
+    juce::File directory;
+    juce::File indexFile;
+    std::vector<HistoryItem> items;
+    std::unordered_map<juce::String, size_t> rowByFileName;    // Nom de fichier → rang dans items
+    bool indexLoaded = false;
+    bool indexDirty = false;                                   // Entrées fusionnées non encore sauvegardées
+    int numParsedFiles = 0;
+
+    bool parseAndCount(const juce::File& file, HistoryItem& outItem);
+    void loadIndex();
+    bool saveIndex() const;
+    void sortAndReindex();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HistoryCatalogue)
+};
@@ -0,0 +1,332 @@
+#include "HistorySearchIndex.h"
+#include "../model/DiatonyTypes.h"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    constexpr int numNotes = 12;
+    constexpr int numDegrees = HistorySearchIndex::numDegrees;
+
+    bool isDegree(int code) { return code >= 0 && code < numDegrees; }
+
+    /** @brief Ajoute row si la liste ne le contient pas déjà (rangs insérés dans l'ordre croissant). */
+    void addPosting(std::vector<int>& postings, int row)
+    {
+        if (postings.empty() || postings.back() != row)
+            postings.push_back(row);
+    }
+
+    /**
+     * @brief Tonalité écrite "Eb", "F#m", "Bbm"... ; false si le jeton n'en est pas une.
+     * isMinor n'est vrai qu'avec le suffixe "m" explicite : "Eb" seul ne fixe pas le mode.
+     */
+    bool parseKey(const juce::String& token, int& note, bool& isMinor)
+    {
+        static const int baseNotes[] = { 9, 11, 0, 2, 4, 5, 7 };   // A B C D E F G
+
+        auto text = token;
+        const auto letter = text[0];
+        if (letter < 'A' || letter > 'G')
+            return false;
+
+        int pitch = baseNotes[letter - 'A'];
+        text = text.substring(1);
+
+        if (text.startsWith("#") || text.startsWith(juce::String::fromUTF8("♯")))
+        {
+            ++pitch;
+            text = text.substring(text.startsWith("#") ? 1 : juce::String::fromUTF8("♯").length());
+        }
+        else if (text.startsWith("b") || text.startsWith(juce::String::fromUTF8("♭")))
+        {
+            --pitch;
+            text = text.substring(text.startsWith("b") ? 1 : juce::String::fromUTF8("♭").length());
+        }
+
+        if (text.isNotEmpty() && text != "m")
+            return false;
+
+        note = (pitch + numNotes) % numNotes;
+        isMinor = text == "m";
+        return true;
+    }
+
+    bool parseSectionRange(const juce::String& range, int& minSections, int& maxSections)
+    {
+        const auto low = range.upToFirstOccurrenceOf("-", false, false).trim();
+        const auto high = range.containsChar('-') ? range.fromFirstOccurrenceOf("-", false, false).trim() : low;
+
+        if (!low.containsOnly("0123456789") || !high.containsOnly("0123456789") || low.isEmpty())
+            return false;
+
+        minSections = low.getIntValue();
+        maxSections = high.isEmpty() ? std::numeric_limits<int>::max() : high.getIntValue();
+        return true;
+    }
+
+    /** @brief Suite de degrés séparés par '>' ou '-' ; false si un élément n'est pas un degré. */
+    bool parseDegreeSequence(const juce::String& token, std::vector<int>& sequence)
+    {
+        auto parts = juce::StringArray::fromTokens(token, ">-", "");
+        parts.removeEmptyStrings();
+        if (parts.isEmpty())
+            return false;
+
+        std::vector<int> degrees;
+        for (const auto& part : parts)
+        {
+            const int degree = HistoryQuery::parseDegree(part);
+            if (degree < 0)
+                return false;
+            degrees.push_back(degree);
+        }
+
+        sequence = std::move(degrees);
+        return true;
+    }
+
+    /** @brief Intersection en place de deux listes triées. */
+    void intersect(std::vector<int>& candidates, const std::vector<int>& postings)
+    {
+        auto out = candidates.begin();
+        auto other = postings.begin();
+
+        for (auto it = candidates.begin(); it != candidates.end() && other != postings.end(); ++it)
+        {
+            other = std::lower_bound(other, postings.end(), *it);
+            if (other != postings.end() && *other == *it)
+                *out++ = *it;
+        }
+
+        candidates.erase(out, candidates.end());
+    }
+}
+
+//==============================================================================
+bool HistoryQuery::isEmpty() const
+{
+    return note < 0 && mode < 0 && minSections <= 0 && maxSections == std::numeric_limits<int>::max()
+        && modulationTypeMask == 0 && degreeSequence.empty() && nameTerms.isEmpty();
+}
+
+int HistoryQuery::parseDegree(const juce::String& token)
+{
+    using Degree = Diatony::ChordDegree;
+    static const std::pair<const char*, Degree> names[] = {
+        { "I", Degree::First }, { "II", Degree::Second }, { "III", Degree::Third },
+        { "IV", Degree::Fourth }, { "V", Degree::Fifth }, { "VI", Degree::Sixth }, { "VII", Degree::Seventh },
+        { "V(APP)", Degree::FifthAppogiatura }, { "VAPP", Degree::FifthAppogiatura },
+        { "V/II", Degree::FiveOfTwo }, { "V/III", Degree::FiveOfThree }, { "V/IV", Degree::FiveOfFour },
+        { "V/V", Degree::FiveOfFive }, { "V/VI", Degree::FiveOfSix }, { "V/VII", Degree::FiveOfSeven },
+        { "BII", Degree::FlatTwo }, { "N6", Degree::FlatTwo }, { "AUG6", Degree::AugmentedSixth }
+    };
+
+    auto text = token.trim().toUpperCase().replace(juce::String::fromUTF8("♭"), "B").removeCharacters(" ");
+
+    for (const auto& [name, degree] : names)
+        if (text == name)
+            return static_cast<int>(degree);
+
+    return -1;
+}
+
+HistoryQuery HistoryQuery::parse(const juce::String& text)
+{
+    HistoryQuery query;
+    bool modeFromToken = false;     // "major"/"minor" l'emporte sur le suffixe d'une tonalité
+
+    // "V/V → V → I" forme un seul jeton "V/V>V>I"
+    auto normalised = text.replace(juce::String::fromUTF8("→"), ">").replace("->", ">");
+    while (normalised.contains(" >") || normalised.contains("> "))
+        normalised = normalised.replace(" >", ">").replace("> ", ">");
+
+    for (const auto& token : juce::StringArray::fromTokens(normalised, " ", "\""))
+    {
+        if (token.isEmpty())
+            continue;
+
+        const auto lower = token.toLowerCase();
+
+        bool keyIsMinor = false;
+
+        if (lower == "major" || lower == "maj")
+        {
+            query.mode = static_cast<int>(Diatony::Mode::Major);
+            modeFromToken = true;
+        }
+        else if (lower == "minor" || lower == "min")
+        {
+            query.mode = static_cast<int>(Diatony::Mode::Minor);
+            modeFromToken = true;
+        }
+        else if (lower == "cadence" || lower == "perfect")
+            query.modulationTypeMask |= 1 << static_cast<int>(Diatony::ModulationType::PerfectCadence);
+        else if (lower == "pivot")
+            query.modulationTypeMask |= 1 << static_cast<int>(Diatony::ModulationType::PivotChord);
+        else if (lower == "alteration")
+            query.modulationTypeMask |= 1 << static_cast<int>(Diatony::ModulationType::Alteration);
+        else if (lower == "chromatic")
+            query.modulationTypeMask |= 1 << static_cast<int>(Diatony::ModulationType::Chromatic);
+        else if (lower.startsWith("s:") && parseSectionRange(lower.substring(2), query.minSections, query.maxSections))
+            continue;
+        else if (parseKey(token, query.note, keyIsMinor))
+        {
+            if (keyIsMinor && !modeFromToken)
+                query.mode = static_cast<int>(Diatony::Mode::Minor);
+        }
+        else if (parseDegreeSequence(token, query.degreeSequence))
+            continue;
+        else
+            query.nameTerms.add(lower);
+    }
+
+    return query;
+}
+
+//==============================================================================
+void HistorySearchIndex::rebuild(const std::vector<HistoryItem>& items)
+{
+    byNote.assign(numNotes, {});
+    byMode.assign(2, {});
+    byModulationType.assign(numModulationTypes, {});
+    byUnigram.assign(numDegrees, {});
+    byBigram.assign(numDegrees * numDegrees, {});
+    byTrigram.assign(numDegrees * numDegrees * numDegrees, {});
+
+    sectionCounts.clear();
+    lowerCaseNames.clear();
+    degreeBuffer.clear();
+    degreeOffsets.assign(1, 0);
+
+    sectionCounts.reserve(items.size());
+    lowerCaseNames.reserve(items.size());
+    degreeOffsets.reserve(items.size() + 1);
+
+    for (int row = 0; row < static_cast<int>(items.size()); ++row)
+    {
+        const auto& item = items[static_cast<size_t>(row)];
+
+        sectionCounts.push_back(item.numSections);
+        lowerCaseNames.push_back(item.name.toLowerCase().toStdString());
+
+        if (item.startNote >= 0 && item.startNote < numNotes)
+        {
+            byNote[static_cast<size_t>(item.startNote)].push_back(row);
+            byMode[item.startIsMajor ? 0 : 1].push_back(row);
+        }
+
+        for (int type = 0; type < numModulationTypes; ++type)
+            if (item.modulationTypeMask & (1 << type))
+                byModulationType[static_cast<size_t>(type)].push_back(row);
+
+        const auto* degrees = static_cast<const juce::uint8*>(item.chordDegrees.getData());
+        const int length = static_cast<int>(item.chordDegrees.getSize());
+        degreeBuffer.insert(degreeBuffer.end(), degrees, degrees + length);
+        degreeOffsets.push_back(degreeBuffer.size());
+
+        // N-grammes : un séparateur de section (ou un degré inconnu) coupe la suite
+        for (int i = 0; i < length; ++i)
+        {
+            const int a = degrees[i];
+            if (!isDegree(a))
+                continue;
+
+            addPosting(byUnigram[static_cast<size_t>(a)], row);
+
+            if (i + 1 >= length || !isDegree(degrees[i + 1]))
+                continue;
+            const int b = degrees[i + 1];
+            addPosting(byBigram[static_cast<size_t>(a * numDegrees + b)], row);
+
+            if (i + 2 >= length || !isDegree(degrees[i + 2]))
+                continue;
+            const int c = degrees[i + 2];
+            addPosting(byTrigram[static_cast<size_t>((a * numDegrees + b) * numDegrees + c)], row);
+        }
+    }
+}
+
+std::vector<int> HistorySearchIndex::search(const HistoryQuery& query) const
+{
+    std::vector<const Postings*> lists;
+
+    if (query.note >= 0)
+    {
+        if (query.note >= numNotes)
+            return {};
+        lists.push_back(&byNote[static_cast<size_t>(query.note)]);
+    }
+
+    if (query.mode >= 0)
+    {
+        if (query.mode > 1)
+            return {};
+        lists.push_back(&byMode[static_cast<size_t>(query.mode)]);
+    }
+
+    if (query.modulationTypeMask >> numModulationTypes)
+        return {};
+    for (int type = 0; type < numModulationTypes; ++type)
+        if (query.modulationTypeMask & (1 << type))
+            lists.push_back(&byModulationType[static_cast<size_t>(type)]);
+
+    const auto& sequence = query.degreeSequence;
+    if (!std::all_of(sequence.begin(), sequence.end(), isDegree))
+        return {};
+
+    if (sequence.size() == 1)
+        lists.push_back(&byUnigram[static_cast<size_t>(sequence[0])]);
+    else if (sequence.size() == 2)
+        lists.push_back(&byBigram[static_cast<size_t>(sequence[0] * numDegrees + sequence[1])]);
+    else
+        for (size_t i = 0; i + 2 < sequence.size(); ++i)
+            lists.push_back(&byTrigram[static_cast<size_t>((sequence[i] * numDegrees + sequence[i + 1]) * numDegrees + sequence[i + 2])]);
+
+    // Listes les plus courtes d'abord : les intersections suivantes ne font que réduire
+    std::sort(lists.begin(), lists.end(), [](const Postings* a, const Postings* b) { return a->size() < b->size(); });
+
+    std::vector<int> candidates;
+    if (lists.empty())
+    {
+        candidates.resize(sectionCounts.size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+    }
+    else
+    {
+        candidates = *lists.front();
+        for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i)
+            intersect(candidates, *lists[i]);
+    }
+
+    std::vector<std::string> terms;
+    for (const auto& term : query.nameTerms)
+        terms.push_back(term.toLowerCase().toStdString());
+
+    const bool verifySequence = sequence.size() > 3;
+
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](int row)
+    {
+        const int sections = sectionCounts[static_cast<size_t>(row)];
+        if (sections < query.minSections || sections > query.maxSections)
+            return true;
+
+        const auto& name = lowerCaseNames[static_cast<size_t>(row)];
+        for (const auto& term : terms)
+            if (name.find(term) == std::string::npos)
+                return true;
+
+        return verifySequence && !containsSequence(row, sequence);
+    }), candidates.end());
+
+    return candidates;
+}
+
+bool HistorySearchIndex::containsSequence(int row, const std::vector<int>& sequence) const
+{
+    const auto begin = degreeBuffer.begin() + static_cast<std::ptrdiff_t>(degreeOffsets[static_cast<size_t>(row)]);
+    const auto end = degreeBuffer.begin() + static_cast<std::ptrdiff_t>(degreeOffsets[static_cast<size_t>(row) + 1]);
+
+    return std::search(begin, end, sequence.begin(), sequence.end(),
+                       [](juce::uint8 degree, int wanted) { return degree == wanted; }) != end;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <limits>
+#include <string>
+#include <vector>
+#include "HistoryCatalogue.h"
+
+/** @brief Critères de filtrage de l'historique ; un critère à sa valeur par défaut est ignoré. */
+struct HistoryQuery
+{
+    int note = -1;                      // Tonalité de départ (0-11)
+    int mode = -1;                      // 0 majeur, 1 mineur (Diatony::Mode)
+    int minSections = 0;
+    int maxSections = std::numeric_limits<int>::max();
+    int modulationTypeMask = 0;         // Tous les types demandés doivent être présents
+    std::vector<int> degreeSequence;    // Suite contiguë de degrés, dans une même section
+    juce::StringArray nameTerms;        // Sous-chaînes du nom (insensible à la casse)
+
+    bool isEmpty() const;
+
+    /**
+     * @brief Construit une requête depuis le champ de recherche.
+     * Jetons : tonalité ("Eb" sans mode, "F#m" mineur), "major"/"minor" (prioritaire sur le suffixe), "s:3" ou "s:2-4", type de modulation
+     * ("cadence", "pivot", "alteration", "chromatic"), suite de degrés ("V/V → V → I", "ii-V-I"),
+     * le reste filtre sur le nom.
+     */
+    static HistoryQuery parse(const juce::String& text);
+
+    /** @brief Degré Diatony::ChordDegree d'un chiffrage ("V/V", "bII", "Aug6"...), -1 sinon. */
+    static int parseDegree(const juce::String& token);
+};
+
+/**
+ * @brief Index inversé en mémoire sur les entrées du catalogue de l'historique.
+ *
+ * Listes de rangs triées par tonalité, mode, type de modulation et n-grammes de degrés (1 à 3,
+ * jamais à cheval sur deux sections). Une requête intersecte les listes les plus courtes d'abord ;
+ * seules les suites de plus de 3 degrés sont vérifiées sur les séquences complètes.
+ * Les rangs renvoyés suivent l'ordre du catalogue (plus récent d'abord).
+ */
+class HistorySearchIndex
+{
+public:
+    void rebuild(const std::vector<HistoryItem>& items);
+    std::vector<int> search(const HistoryQuery& query) const;
+    int getNumItems() const { return static_cast<int>(sectionCounts.size()); }
+
+    static constexpr int numDegrees = 16;
+    static constexpr int numModulationTypes = 4;
+
+private:
+    using Postings = std::vector<int>;
+
+    std::vector<Postings> byNote;               // 12
+    std::vector<Postings> byMode;               // 2
+    std::vector<Postings> byModulationType;     // numModulationTypes
+    std::vector<Postings> byUnigram;            // numDegrees
+    std::vector<Postings> byBigram;             // numDegrees²
+    std::vector<Postings> byTrigram;            // numDegrees³
+
+    std::vector<int> sectionCounts;
+    std::vector<std::string> lowerCaseNames;
+    std::vector<juce::uint8> degreeBuffer;      // Séquences de tous les éléments, bout à bout
+    std::vector<size_t> degreeOffsets;          // Début de l'élément i dans degreeBuffer (taille n + 1)
+
+    bool containsSequence(int row, const std::vector<int>& sequence) const;
+};
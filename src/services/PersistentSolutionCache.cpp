@@ -0,0 +1,219 @@
+#include "PersistentSolutionCache.h"
+
+namespace {
+    void writeKey(juce::OutputStream& out, const SolutionCache::ProblemKey& key)
+    {
+        out.writeInt64(static_cast<juce::int64>(key.high));
+        out.writeInt64(static_cast<juce::int64>(key.low));
+    }
+    
+    juce::uint64 readUInt64(const juce::uint8* p) { return juce::ByteOrder::littleEndianInt64(p); }
+    juce::uint32 readUInt32(const juce::uint8* p) { return juce::ByteOrder::littleEndianInt(p); }
+    
+    /** @brief Verrou inter-processus avec délai (ScopedLockType attend indéfiniment). */
+    class ScopedProcessLock
+    {
+    public:
+        ScopedProcessLock(juce::InterProcessLock& lockToEnter, int timeoutMs)
+            : processLock(lockToEnter), locked(lockToEnter.enter(timeoutMs)) {}
+        ~ScopedProcessLock() { if (locked) processLock.exit(); }
+        
+        bool isLocked() const { return locked; }
+        
+    private:
+        juce::InterProcessLock& processLock;
+        const bool locked;
+        
+        JUCE_DECLARE_NON_COPYABLE(ScopedProcessLock)
+    };
+}
+
+PersistentSolutionCache::PersistentSolutionCache(const juce::File& cacheFile)
+    : file(cacheFile),
+      processLock("DiatonySolutionCache_" + juce::String::toHexString(cacheFile.getFullPathName().hashCode64()))
+{
+    // Rien n'est lu ici : le fichier est mappé au premier lookup
+}
+
+int PersistentSolutionCache::getNumIndexedEntries() const
+{
+    const juce::ScopedLock sl(lock);
+    return static_cast<int>(offsets.size());
+}
+
+juce::uint32 PersistentSolutionCache::computeChecksum(const SolutionCache::ProblemKey& key,
+                                                      const juce::uint8* notes, juce::uint32 numNotes)
+{
+    // FNV-1a 32 bits sur clé + longueur + notes
+    juce::uint32 hash = 0x811c9dc5u;
+    auto mix = [&hash](juce::uint8 byte) { hash = (hash ^ byte) * 0x01000193u; };
+    
+    for (int i = 0; i < 8; ++i) mix(static_cast<juce::uint8>(key.high >> (8 * i)));
+    for (int i = 0; i < 8; ++i) mix(static_cast<juce::uint8>(key.low >> (8 * i)));
+    for (int i = 0; i < 4; ++i) mix(static_cast<juce::uint8>(numNotes >> (8 * i)));
+    for (juce::uint32 i = 0; i < numNotes; ++i) mix(notes[i]);
+    
+    return hash;
+}
+
+void PersistentSolutionCache::resetIndex()
+{
+    mappedFile.reset();
+    offsets.clear();
+    indexedBytes = 0;
+}
+
+void PersistentSolutionCache::refreshIndex()
+{
+    // Le parcours lit la fin du fichier : on l'exclut d'une réparation concurrente
+    ScopedProcessLock processScope(processLock, processLockTimeoutMs);
+    if (!processScope.isLocked())
+        return;
+    
+    const auto fileSize = file.getSize();
+    
+    // Fichier supprimé, tronqué ou recréé : on repart de zéro
+    if (fileSize < indexedBytes || (mappedFile != nullptr && fileSize < static_cast<juce::int64>(mappedFile->getSize())))
+        resetIndex();
+    
+    if (fileSize < headerSize || (mappedFile != nullptr && fileSize == static_cast<juce::int64>(mappedFile->getSize())))
+        return;
+    
+    mappedFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly, false);
+    if (mappedFile->getData() == nullptr)
+    {
+        mappedFile.reset();
+        return;
+    }
+    
+    const auto* data = static_cast<const juce::uint8*>(mappedFile->getData());
+    const auto mappedSize = static_cast<juce::int64>(mappedFile->getSize());
+    
+    if (indexedBytes == 0)
+    {
+        if (mappedSize < headerSize || readUInt32(data) != fileMagic || readUInt32(data + 4) != formatVersion)
+            return;  // Autre format : ignoré (et réinitialisé au prochain append)
+        
+        indexedBytes = headerSize;
+    }
+    
+    indexNewRecords(data, mappedSize);
+}
+
+void PersistentSolutionCache::indexNewRecords(const juce::uint8* data, juce::int64 size)
+{
+    while (indexedBytes + recordHeaderSize <= size)
+    {
+        const auto* record = data + indexedBytes;
+        
+        SolutionCache::ProblemKey key;
+        key.high = readUInt64(record);
+        key.low = readUInt64(record + 8);
+        const auto numNotes = readUInt32(record + 16);
+        const auto checksum = readUInt32(record + 20);
+        
+        if (indexedBytes + recordHeaderSize + numNotes > size)
+            break;  // Enregistrement en cours d'écriture ou tronqué
+        
+        if (computeChecksum(key, record + recordHeaderSize, numNotes) != checksum)
+            break;
+        
+        offsets.emplace(key, indexedBytes);
+        indexedBytes += recordHeaderSize + numNotes;
+    }
+}
+
+bool PersistentSolutionCache::lookup(const SolutionCache::ProblemKey& key, std::vector<int>& outVoicing)
+{
+    const juce::ScopedLock sl(lock);
+    
+    auto it = offsets.find(key);
+    if (it == offsets.end() || mappedFile == nullptr)
+    {
+        // Peut-être ajouté entre-temps par une autre instance (ou mapping relâché par un append)
+        refreshIndex();
+        it = offsets.find(key);
+        if (it == offsets.end() || mappedFile == nullptr)
+            return false;
+    }
+    
+    // Les écritures ne tronquent que sous ce verrou : tant qu'on le tient, la taille vérifiée reste valable.
+    // Lire une page mappée au-delà de la fin du fichier provoquerait un SIGBUS
+    ScopedProcessLock processScope(processLock, processLockTimeoutMs);
+    if (!processScope.isLocked())
+        return false;
+    
+    const auto mappedSize = static_cast<juce::int64>(mappedFile->getSize());
+    if (file.getSize() < mappedSize)
+    {
+        resetIndex();
+        return false;
+    }
+    
+    const auto* record = static_cast<const juce::uint8*>(mappedFile->getData()) + it->second;
+    const auto numNotes = readUInt32(record + 16);
+    if (it->second + recordHeaderSize + static_cast<juce::int64>(numNotes) > mappedSize)
+        return false;
+    
+    const auto* notes = record + recordHeaderSize;
+    outVoicing.assign(notes, notes + numNotes);
+    return true;
+}
+
+bool PersistentSolutionCache::append(const SolutionCache::ProblemKey& key, const std::vector<int>& voicing)
+{
+    const juce::ScopedLock sl(lock);
+    
+    std::vector<juce::uint8> notes;
+    notes.reserve(voicing.size());
+    for (int note : voicing)
+    {
+        if (note < 0 || note > 127)
+            return false;
+        notes.push_back(static_cast<juce::uint8>(note));
+    }
+    
+    ScopedProcessLock processScope(processLock, processLockTimeoutMs);
+    if (!processScope.isLocked())
+        return false;   // Une autre instance écrit : la solution sera mise en cache plus tard
+    
+    refreshIndex();
+    if (offsets.find(key) != offsets.end())
+        return true;  // Déjà écrit par une autre instance
+    
+    file.getParentDirectory().createDirectory();
+    
+    // Le mapping couvre peut-être la fin qu'on va écraser : on le relâche avant de tronquer
+    mappedFile.reset();
+    
+    juce::FileOutputStream out(file);
+    if (!out.openedOk())
+        return false;
+    
+    if (indexedBytes == 0)
+    {
+        // Fichier neuf (ou d'un autre format) : nouvel en-tête
+        out.setPosition(0);
+        out.truncate();
+        out.writeInt(static_cast<int>(fileMagic));
+        out.writeInt(static_cast<int>(formatVersion));
+        out.writeInt64(0);  // Réservé
+        indexedBytes = headerSize;
+    }
+    else
+    {
+        // Écrase un éventuel enregistrement tronqué laissé par un crash
+        out.setPosition(indexedBytes);
+        out.truncate();
+    }
+    
+    const auto numNotes = static_cast<juce::uint32>(notes.size());
+    writeKey(out, key);
+    out.writeInt(static_cast<int>(numNotes));
+    out.writeInt(static_cast<int>(computeChecksum(key, notes.data(), numNotes)));
+    out.write(notes.data(), notes.size());
+    out.flush();
+    
+    // L'index sera complété au prochain refreshIndex (lecture depuis indexedBytes)
+    return !out.getStatus().failed();
+}
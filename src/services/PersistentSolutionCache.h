@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <unordered_map>
+#include <memory>
+#include <vector>
+#include "SolutionCache.h"
+
+/**
+ * @brief Cache de solutions sur disque, partagé entre sessions et instances du plugin.
+ *
+ * Fichier en ajout seul : en-tête puis enregistrements [clé 128 bits | n | checksum | n notes].
+ * Lecture par juce::MemoryMappedFile, mappé au premier accès puis indexé par la fin
+ * (seuls les octets ajoutés depuis le dernier index sont parcourus).
+ * Les écritures sont sérialisées entre processus par un juce::InterProcessLock, pris avec un délai
+ * borné : une autre instance bloquée en pleine écriture se traduit par un défaut de cache, jamais
+ * par une attente. Un enregistrement tronqué (crash pendant l'écriture) est ignoré puis écrasé.
+ */
+class PersistentSolutionCache
+{
+public:
+    explicit PersistentSolutionCache(const juce::File& cacheFile);
+    
+    bool lookup(const SolutionCache::ProblemKey& key, std::vector<int>& outVoicing);
+    bool append(const SolutionCache::ProblemKey& key, const std::vector<int>& voicing);
+    
+    int getNumIndexedEntries() const;
+    const juce::File& getFile() const { return file; }
+    
+    static constexpr juce::uint32 fileMagic = 0x31435344;    // "DSC1"
+    static constexpr juce::uint32 formatVersion = 1;
+    static constexpr int headerSize = 16;
+    static constexpr int recordHeaderSize = 24;              // clé (16) + n (4) + checksum (4)
+    static constexpr int processLockTimeoutMs = 50;          // Au-delà : traité comme un défaut de cache
+    
+private:
+    juce::File file;
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    juce::int64 indexedBytes = 0;                            // Octets valides déjà indexés
+    std::unordered_map<SolutionCache::ProblemKey, juce::int64, SolutionCache::KeyHasher> offsets;
+    juce::InterProcessLock processLock;
+    mutable juce::CriticalSection lock;
+    
+    /** @brief Relâche le mapping et l'index (fichier tronqué ou recréé par une autre instance). */
+    void resetIndex();
+    
+    /** @brief Remappe si le fichier a grandi et indexe les nouveaux enregistrements. */
+    void refreshIndex();
+    
+    /** @brief Parcourt les enregistrements à partir de indexedBytes ; s'arrête au premier invalide. */
+    void indexNewRecords(const juce::uint8* data, juce::int64 size);
+    
+    static juce::uint32 computeChecksum(const SolutionCache::ProblemKey& key, const juce::uint8* notes, juce::uint32 numNotes);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PersistentSolutionCache)
+};
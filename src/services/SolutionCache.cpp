@@ -0,0 +1,134 @@
+#include "SolutionCache.h"
+#include "PersistentSolutionCache.h"
+
+namespace {
+    constexpr juce::uint64 fnvPrime = 0x100000001b3ULL;
+    constexpr juce::uint64 fnvOffsetHigh = 0xcbf29ce484222325ULL;  // Base FNV-1a standard
+    constexpr juce::uint64 fnvOffsetLow = 0x84222325cbf29ce4ULL;   // Base permutée : flux indépendant
+    
+    juce::uint64 splitMix64(juce::uint64 x)
+    {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+}
+
+//==============================================================================
+juce::String SolutionCache::ProblemKey::toString() const
+{
+    return juce::String::toHexString(static_cast<juce::int64>(high)).paddedLeft('0', 16)
+         + juce::String::toHexString(static_cast<juce::int64>(low)).paddedLeft('0', 16);
+}
+
+//==============================================================================
+SolutionCache::KeyBuilder::KeyBuilder() : high(fnvOffsetHigh), low(fnvOffsetLow) {}
+
+void SolutionCache::KeyBuilder::addByte(juce::uint8 byte)
+{
+    high = (high ^ byte) * fnvPrime;
+    low = (low ^ static_cast<juce::uint8>(byte ^ 0x5a)) * fnvPrime;
+}
+
+void SolutionCache::KeyBuilder::add(int value)
+{
+    // Little-endian explicite : même clé quelle que soit la plateforme
+    auto bits = static_cast<juce::uint32>(value);
+    for (int i = 0; i < 4; ++i)
+        addByte(static_cast<juce::uint8>((bits >> (8 * i)) & 0xff));
+    ++count;
+}
+
+void SolutionCache::KeyBuilder::add(const std::vector<int>& values)
+{
+    // La longueur préfixe le contenu : [1,2][3] et [1][2,3] donnent des clés différentes
+    add(static_cast<int>(values.size()));
+    for (int value : values)
+        add(value);
+}
+
+SolutionCache::ProblemKey SolutionCache::KeyBuilder::finish() const
+{
+    ProblemKey key;
+    key.high = splitMix64(high ^ count);
+    key.low = splitMix64(low + count);
+    return key;
+}
+
+//==============================================================================
+SolutionCache::SolutionCache() = default;
+SolutionCache::~SolutionCache() = default;
+
+void SolutionCache::attachPersistentStore(const juce::File& cacheFile)
+{
+    const juce::ScopedLock sl(lock);
+    
+    if (persistentStore == nullptr)
+        persistentStore = std::make_unique<PersistentSolutionCache>(cacheFile);
+}
+
+bool SolutionCache::lookup(const ProblemKey& key, std::vector<int>& outVoicing)
+{
+    const juce::ScopedLock sl(lock);
+    
+    auto it = entries.find(key);
+    if (it != entries.end())
+    {
+        ++hits;
+        outVoicing = it->second;
+        return true;
+    }
+    
+    if (persistentStore != nullptr && persistentStore->lookup(key, outVoicing))
+    {
+        ++hits;
+        ++diskHits;
+        insertInMemory(key, outVoicing);
+        return true;
+    }
+    
+    ++misses;
+    return false;
+}
+
+void SolutionCache::store(const ProblemKey& key, const std::vector<int>& voicing)
+{
+    const juce::ScopedLock sl(lock);
+    
+    if (entries.find(key) != entries.end())
+        return;
+    
+    insertInMemory(key, voicing);
+    
+    if (persistentStore != nullptr)
+        persistentStore->append(key, voicing);
+}
+
+void SolutionCache::insertInMemory(const ProblemKey& key, const std::vector<int>& voicing)
+{
+    entries.emplace(key, voicing);
+    insertionOrder.push_back(key);
+    
+    while (static_cast<int>(insertionOrder.size()) > maxEntries)
+    {
+        entries.erase(insertionOrder.front());
+        insertionOrder.pop_front();
+    }
+}
+
+SolutionCache::Stats SolutionCache::getStats() const
+{
+    const juce::ScopedLock sl(lock);
+    return { hits, misses, static_cast<int>(entries.size()), diskHits };
+}
+
+void SolutionCache::clear()
+{
+    const juce::ScopedLock sl(lock);
+    entries.clear();
+    insertionOrder.clear();
+    hits = 0;
+    misses = 0;
+    diskHits = 0;
+}
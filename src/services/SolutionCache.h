@@ -0,0 +1,102 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <unordered_map>
+#include <deque>
+#include <vector>
+#include <memory>
+
+class PersistentSolutionCache;
+
+/**
+ * @brief Cache de solutions adressé par le contenu du problème harmonique.
+ *
+ * Clé : hash 128 bits du problème canonique (tonalités, degrés, qualités résolues, états,
+ * modulations et indices globaux). Valeur : voicing de la solution (4 notes MIDI par accord).
+ * Partagé par toutes les instances du plugin via juce::SharedResourcePointer ; thread-safe.
+ */
+class SolutionCache
+{
+public:
+    /** @brief Hash 128 bits d'un problème canonique. */
+    struct ProblemKey
+    {
+        juce::uint64 high = 0;
+        juce::uint64 low = 0;
+        
+        bool operator==(const ProblemKey& other) const { return high == other.high && low == other.low; }
+        bool operator!=(const ProblemKey& other) const { return !(*this == other); }
+        juce::String toString() const;
+    };
+    
+    /**
+     * @brief Accumule les entiers du problème dans un ordre fixe puis produit la clé.
+     * Deux flux FNV-1a 64 bits indépendants, finalisés par un mélange splitmix64 :
+     * stable d'une exécution et d'une plateforme à l'autre.
+     */
+    class KeyBuilder
+    {
+    public:
+        KeyBuilder();
+        
+        void add(int value);
+        void add(bool value) { add(value ? 1 : 0); }
+        void add(const std::vector<int>& values);
+        
+        ProblemKey finish() const;
+        
+    private:
+        juce::uint64 high;
+        juce::uint64 low;
+        juce::uint64 count = 0;
+        
+        void addByte(juce::uint8 byte);
+    };
+    
+    struct Stats
+    {
+        int hits = 0;
+        int misses = 0;
+        int entries = 0;
+        int diskHits = 0;           // Hits servis par le cache persistant (inclus dans hits)
+    };
+    
+    SolutionCache();
+    ~SolutionCache();
+    
+    /**
+     * @brief Adosse le cache mémoire à un fichier persistant (sans effet si déjà fait).
+     * Sans appel, le cache reste purement en mémoire.
+     */
+    void attachPersistentStore(const juce::File& cacheFile);
+    
+    /** @brief Copie le voicing dans outVoicing si la clé est connue (mémoire puis disque) ; compte un hit ou un miss. */
+    bool lookup(const ProblemKey& key, std::vector<int>& outVoicing);
+    
+    /** @brief Enregistre un voicing (et l'ajoute au fichier persistant) ; évince l'entrée la plus ancienne au-delà de maxEntries. */
+    void store(const ProblemKey& key, const std::vector<int>& voicing);
+    
+    Stats getStats() const;
+    void clear();
+    
+    static constexpr int maxEntries = 256;
+    
+    /** @brief Hash de ProblemKey pour les conteneurs non ordonnés (partagé avec le cache persistant). */
+    struct KeyHasher
+    {
+        size_t operator()(const ProblemKey& key) const { return static_cast<size_t>(key.low ^ (key.high * 31)); }
+    };
+    
+private:
+    std::unordered_map<ProblemKey, std::vector<int>, KeyHasher> entries;
+    std::deque<ProblemKey> insertionOrder;
+    int hits = 0;
+    int misses = 0;
+    int diskHits = 0;
+    std::unique_ptr<PersistentSolutionCache> persistentStore;
+    juce::CriticalSection lock;
+    
+    void insertInMemory(const ProblemKey& key, const std::vector<int>& voicing);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SolutionCache)
+};
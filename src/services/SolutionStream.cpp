@@ -0,0 +1,29 @@
+#include "SolutionStream.h"
+
+bool SolutionStream::push(const StreamedSolution& solution)
+{
+    auto scope = fifo.write(1);
+    
+    if (scope.blockSize1 > 0)
+        slots[static_cast<size_t>(scope.startIndex1)] = solution;
+    else if (scope.blockSize2 > 0)
+        slots[static_cast<size_t>(scope.startIndex2)] = solution;
+    else
+        return false;
+    
+    return true;
+}
+
+bool SolutionStream::pop(StreamedSolution& solution)
+{
+    auto scope = fifo.read(1);
+    
+    if (scope.blockSize1 > 0)
+        solution = std::move(slots[static_cast<size_t>(scope.startIndex1)]);
+    else if (scope.blockSize2 > 0)
+        solution = std::move(slots[static_cast<size_t>(scope.startIndex2)]);
+    else
+        return false;
+    
+    return true;
+}
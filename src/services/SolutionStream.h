@@ -0,0 +1,42 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+
+/** @brief Une solution énumérée, prête à être auditionnée (fichier MIDI déjà écrit). */
+struct StreamedSolution
+{
+    int jobId = 0;
+    int solutionIndex = 0;      // 1-based : "solution i of K"
+    int requestedCount = 0;     // K demandé
+    bool isLast = false;        // Plus aucune solution à venir pour cette requête
+    juce::String midiPath;
+};
+
+/**
+ * @brief File SPSC sans verrou (juce::AbstractFifo) : thread solveur → message thread.
+ *
+ * Un seul producteur (le worker de GenerationService) et un seul consommateur
+ * (AppController::handleAsyncUpdate). Capacité fixe ; push échoue si la file est pleine.
+ */
+class SolutionStream
+{
+public:
+    static constexpr int capacity = 32;
+    
+    SolutionStream() : fifo(capacity) {}
+    
+    /** @brief Côté producteur (thread solveur). */
+    bool push(const StreamedSolution& solution);
+    
+    /** @brief Côté consommateur (message thread) ; false si la file est vide. */
+    bool pop(StreamedSolution& solution);
+    
+    int getNumReady() const { return fifo.getNumReady(); }
+    
+private:
+    juce::AbstractFifo fifo;
+    std::array<StreamedSolution, capacity> slots;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SolutionStream)
+};
@@ -0,0 +1,54 @@
+#include "VoicingMidiWriter.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace VoicingMidiWriter
+{
+    bool write(const std::vector<int>& voicing, const juce::File& outputFile, juce::String& errorMessage)
+    {
+        if (voicing.empty() || voicing.size() % voicesPerChord != 0)
+        {
+            errorMessage = "Invalid voicing size: " + juce::String(static_cast<int>(voicing.size()));
+            return false;
+        }
+        
+        const int chordTicks = ticksPerQuarterNote * beatsPerChord;
+        const int numChords = static_cast<int>(voicing.size()) / voicesPerChord;
+        
+        juce::MidiMessageSequence track;
+        track.addEvent(juce::MidiMessage::tempoMetaEvent(500000), 0.0);   // 120 BPM
+        track.addEvent(juce::MidiMessage::timeSignatureMetaEvent(4, 4), 0.0);
+        
+        for (int chord = 0; chord < numChords; ++chord)
+        {
+            const double start = static_cast<double>(chord * chordTicks);
+            const double end = start + chordTicks;
+            
+            for (int voice = 0; voice < voicesPerChord; ++voice)
+            {
+                const int note = voicing[static_cast<size_t>(chord * voicesPerChord + voice)];
+                if (note < 0 || note > 127)
+                    continue;
+                
+                track.addEvent(juce::MidiMessage::noteOn(1, note, static_cast<juce::uint8>(100)), start);
+                track.addEvent(juce::MidiMessage::noteOff(1, note), end);
+            }
+        }
+        
+        track.updateMatchedPairs();
+        
+        juce::MidiFile midiFile;
+        midiFile.setTicksPerQuarterNote(ticksPerQuarterNote);
+        midiFile.addTrack(track);
+        
+        outputFile.deleteFile();
+        juce::FileOutputStream stream(outputFile);
+        
+        if (!stream.openedOk() || !midiFile.writeTo(stream))
+        {
+            errorMessage = "Unable to write " + outputFile.getFullPathName();
+            return false;
+        }
+        
+        return true;
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+/**
+ * @brief Écrit un voicing à quatre voix dans un fichier MIDI standard.
+ *
+ * Format du voicing : 4 notes MIDI par accord, dans l'ordre basse, ténor, alto, soprano.
+ * Utilisé pour les solutions fraîches comme pour celles servies par le cache :
+ * le fichier produit est identique dans les deux cas.
+ *
+ * Remplace writeSolToMIDIFile de Diatony, dont la disposition diffère : les fichiers écrits
+ * avant ce remplacement ne sont pas identiques octet pour octet. Disposition produite :
+ * - SMF format 1, une seule piste, 480 ticks par noire ;
+ * - tempo 120 BPM et mesure 4/4 au tick 0 ;
+ * - les quatre voix sur le canal 1, vélocité 100, note-off de vélocité 0 ;
+ * - un accord par mesure (ronde), notes hors 0-127 ignorées.
+ * La référence est figée par le test « Écriture MIDI : disposition de référence ».
+ */
+namespace VoicingMidiWriter
+{
+    constexpr int voicesPerChord = 4;
+    constexpr int ticksPerQuarterNote = 480;
+    constexpr int beatsPerChord = 4;    // Un accord par mesure (ronde)
+    
+    /** @brief Retourne false et renseigne errorMessage en cas d'échec. */
+    bool write(const std::vector<int>& voicing, const juce::File& outputFile, juce::String& errorMessage);
+}
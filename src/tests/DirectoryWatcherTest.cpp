@@ -0,0 +1,78 @@
+#include <JuceHeader.h>
+#include "services/DirectoryWatcher.h"
+
+/** @brief Tests unitaires pour DirectoryWatcher (deltas d'un dossier, natif et polling). */
+class DirectoryWatcherTest : public juce::UnitTest
+{
+public:
+    DirectoryWatcherTest() : juce::UnitTest("DirectoryWatcher Tests", "history_tests") {}
+
+    void runTest() override
+    {
+        beginTest(juce::String::fromUTF8("Polling : ajout, modification, suppression"));
+        {
+            runScenario(DirectoryWatcher::Backend::polling);
+            logMessage(juce::String::fromUTF8("✓ Deltas par comparaison date/taille"));
+        }
+
+        beginTest(juce::String::fromUTF8("Natif (inotify) ou repli sur le polling"));
+        {
+            runScenario(DirectoryWatcher::Backend::native);
+            logMessage(juce::String::fromUTF8("✓ Deltas via le backend natif"));
+        }
+    }
+
+private:
+    struct Delta
+    {
+        juce::String name;
+        DirectoryWatcher::ChangeType change;
+    };
+
+    void runScenario(DirectoryWatcher::Backend backend)
+    {
+        auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                             .getNonexistentChildFile("diatony_watch_test", "");
+        directory.createDirectory();
+        directory.getChildFile("existing.diatony").replaceWithText("<Piece/>");
+
+        std::vector<Delta> deltas;
+        DirectoryWatcher watcher(directory, "*.diatony", backend);
+        watcher.onChange = [&deltas](const juce::File& file, DirectoryWatcher::ChangeType change) {
+            deltas.push_back({ file.getFileName(), change });
+        };
+
+        watcher.start();
+        expect(watcher.isWatching(), "Surveillance démarrée");
+        watcher.poll();
+        expect(deltas.empty(), "Fichiers présents au démarrage : aucun delta");
+
+        directory.getChildFile("new.diatony").replaceWithText("<Piece/>");
+        directory.getChildFile("ignored.txt").replaceWithText("x");
+        watcher.poll();
+        expectEquals(static_cast<int>(deltas.size()), 1, "Seul le .diatony est signalé");
+        if (deltas.size() == 1)
+        {
+            expectEquals(deltas[0].name, juce::String("new.diatony"));
+            expect(deltas[0].change == DirectoryWatcher::ChangeType::added, "Ajout");
+        }
+
+        deltas.clear();
+        directory.getChildFile("existing.diatony").replaceWithText("<Piece><Section/></Piece>");
+        watcher.poll();
+        expect(!deltas.empty() && deltas.back().change == DirectoryWatcher::ChangeType::modified, "Modification");
+
+        deltas.clear();
+        directory.getChildFile("new.diatony").deleteFile();
+        watcher.poll();
+        expectEquals(static_cast<int>(deltas.size()), 1, "Une suppression");
+        if (deltas.size() == 1)
+            expect(deltas[0].change == DirectoryWatcher::ChangeType::removed, "Suppression");
+
+        watcher.stop();
+        expect(!watcher.isWatching(), "Surveillance arrêtée");
+        directory.deleteRecursively();
+    }
+};
+
+static DirectoryWatcherTest directoryWatcherTest;
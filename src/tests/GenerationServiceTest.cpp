@@ -1,10 +1,13 @@
 #include <JuceHeader.h>
 #include "services/GenerationService.h"
+#include "services/SolutionStream.h"
+#include "services/VoicingMidiWriter.h"
 #include "model/Piece.h"
 #include "model/Section.h"
 #include "model/Progression.h"
 #include "model/Chord.h"
 #include "model/DiatonyTypes.h"
+#include "model/SyntheticPieceGenerator.h"
 
 /** @brief Tests unitaires pour le GenerationService (lecture du modèle ValueTree). */
 class GenerationServiceTest : public juce::UnitTest
@@ -127,6 +130,368 @@ public:
             logMessage(juce::String::fromUTF8("✓ Pièce vide gérée sans crash"));
         }
         
+        beginTest(juce::String::fromUTF8("Taille du portfolio configurable"));
+        {
+            GenerationService service;
+            
+            expect(service.getPortfolioSize() >= 1, "Au moins un worker par défaut");
+            expectEquals(service.getPortfolioSize(), GenerationService::getDefaultPortfolioSize(), "Taille par défaut");
+            
+            service.setPortfolioSize(4);
+            expectEquals(service.getPortfolioSize(), 4, "4 workers");
+            
+            service.setPortfolioSize(0);
+            expectEquals(service.getPortfolioSize(), 1, "Taille bornée à 1");
+            
+            auto result = service.getLastResult();
+            expect(!result.success, "Aucun résultat avant génération");
+            expectEquals(result.winningWorker, -1, "Aucun worker gagnant");
+            
+            logMessage(juce::String::fromUTF8("✓ Portfolio configurable"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Annulation et budget"));
+        {
+            GenerationService service;
+            
+            GenerationBudget budget;
+            expectEquals(budget.timeLimitMs, 0, "Pas de limite de temps par défaut");
+            expectEquals(static_cast<int>(budget.nodeLimit), 0, "Pas de limite de nœuds par défaut");
+            expectEquals(budget.optimiseForMs, 0, "Mode anytime désactivé par défaut");
+            expect(service.getLastResult().costTrajectory.empty(), "Pas de trajectoire de coût au repos");
+            
+            expect(!service.isCancellationRequested(), "Pas d'annulation initiale");
+            service.cancelGeneration();
+            expect(service.isCancellationRequested(), "Annulation enregistrée");
+            expect(!service.isGenerating(), "Annuler sans génération ne lance rien");
+            
+            logMessage(juce::String::fromUTF8("✓ Annulation et budget"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Annulation d'une résolution en cours"));
+        {
+            Piece piece("Cancel");
+            SyntheticPieceGenerator::Options options;
+            options.totalChords = 400;
+            SyntheticPieceGenerator::generate(piece, options);
+            
+            auto output = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                              .getNonexistentChildFile("diatony_cancel_test", ".mid");
+            
+            GenerationService service;
+            service.setCacheEnabled(false);
+            expect(service.startGeneration(piece, output.getFullPathName(), nullptr), "Requête acceptée");
+            
+            // Laisse la recherche démarrer avant d'annuler
+            juce::Thread::sleep(200);
+            expect(service.isGenerating(), "Recherche en cours");
+            
+            const auto cancelMs = juce::Time::getMillisecondCounterHiRes();
+            service.cancelGeneration();
+            
+            while (service.isGenerating() && juce::Time::getMillisecondCounterHiRes() - cancelMs < 5000.0)
+                juce::Thread::sleep(5);
+            const auto stopDelayMs = juce::Time::getMillisecondCounterHiRes() - cancelMs;
+            
+            expect(!service.isGenerating(), "Worker libéré");
+            expect(stopDelayMs < 1000.0, "Arrêt rapide (" + juce::String(stopDelayMs, 1) + " ms)");
+            
+            auto result = service.getLastResult();
+            expect(!result.success, "Pas de solution livrée");
+            expect(result.cancelled, "Résultat marqué annulé");
+            expect(!output.existsAsFile(), "Aucun MIDI écrit");
+            
+            output.deleteFile();
+            logMessage(juce::String::fromUTF8("✓ Annulation en ") + juce::String(stopDelayMs, 1) + " ms");
+        }
+        
+        beginTest(juce::String::fromUTF8("File de requêtes avec coalescence"));
+        {
+            GenerationService service;
+            Piece piece("Empty Piece");
+            
+            expectEquals(service.getLatestJobId(), 0, "Aucune requête au départ");
+            
+            // Plus de refus "génération déjà en cours" : chaque requête est acceptée
+            expect(service.startGeneration(piece, "", nullptr), "1re requête acceptée");
+            expect(service.startGeneration(piece, "", nullptr), "2e requête acceptée");
+            expectEquals(service.getLatestJobId(), 2, "La dernière requête remplace la précédente");
+            
+            // Pièce vide : la validation échoue aussitôt, le worker se libère
+            for (int i = 0; i < 100 && service.isGenerating(); ++i)
+                juce::Thread::sleep(10);
+            
+            expect(!service.isGenerating(), "File vidée");
+            expectEquals(service.getLastResult().jobId, 2, "Seul le résultat de la dernière requête est conservé");
+            expect(service.getLastResult().inputValidationError, "Pièce vide → warning de validation");
+            
+            logMessage(juce::String::fromUTF8("✓ Requêtes coalescées"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Énumération et file de solutions"));
+        {
+            GenerationService service;
+            expectEquals(service.getEnumerationCount(), 1, "Solution unique par défaut");
+            
+            service.setEnumerationCount(5);
+            expectEquals(service.getEnumerationCount(), 5, "5 solutions demandées");
+            service.setEnumerationCount(1000);
+            expectEquals(service.getEnumerationCount(), GenerationService::maxEnumeratedSolutions, "K borné");
+            
+            StreamedSolution popped;
+            expect(!service.popStreamedSolution(popped), "Aucune solution streamée au repos");
+            
+            SolutionStream stream;
+            expect(stream.push({ 1, 1, 3, false, "a.mid" }), "Push 1");
+            expect(stream.push({ 1, 2, 3, true, "b.mid" }), "Push 2");
+            expectEquals(stream.getNumReady(), 2, "2 solutions en attente");
+            
+            expect(stream.pop(popped), "Pop 1");
+            expectEquals(popped.solutionIndex, 1, "Ordre FIFO conservé");
+            expect(stream.pop(popped), "Pop 2");
+            expect(popped.isLast, "Dernière solution signalée");
+            expect(!stream.pop(popped), "File vide");
+            
+            int pushed = 0;
+            while (stream.push({ 2, pushed + 1, 0, false, {} }))
+                ++pushed;
+            expect(pushed < SolutionStream::capacity + 1, "Capacité bornée, push refusé quand plein");
+            
+            logMessage(juce::String::fromUTF8("✓ Énumération configurable, file SPSC"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Énumération de bout en bout : K fichiers distincts"));
+        {
+            auto folder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                              .getNonexistentChildFile("diatony_enumeration_test", "");
+            folder.createDirectory();
+            
+            Piece piece("Enumeration");
+            piece.addSection("A");
+            auto progression = piece.getSection(0).getProgression();
+            progression.addChord(Diatony::ChordDegree::First);
+            progression.addChord(Diatony::ChordDegree::Fourth);
+            progression.addChord(Diatony::ChordDegree::Fifth);
+            progression.addChord(Diatony::ChordDegree::First);
+            
+            GenerationService service;
+            service.setCacheEnabled(false);
+            service.setEnumerationCount(3);
+            
+            auto result = service.generateNow(piece, folder.getChildFile("enum.mid").getFullPathName());
+            expect(result.success, "Première solution");
+            
+            juce::StringArray paths;
+            bool sawLast = false;
+            StreamedSolution streamed;
+            while (service.popStreamedSolution(streamed))
+            {
+                if (streamed.midiPath.isNotEmpty())
+                    paths.addIfNotAlreadyThere(streamed.midiPath);
+                sawLast = sawLast || streamed.isLast;
+            }
+            
+            expect(sawLast, "Fin de l'énumération signalée");
+            expectEquals(paths.size(), 3, "K solutions streamées");
+            expect(paths.contains(folder.getChildFile("enum_alt2.mid").getFullPathName()), "_alt2.mid");
+            expect(paths.contains(folder.getChildFile("enum_alt3.mid").getFullPathName()), "_alt3.mid");
+            
+            juce::Array<juce::MemoryBlock> contents;
+            for (const auto& path : paths)
+            {
+                juce::MemoryBlock data;
+                expect(juce::File(path).loadFileAsData(data), "Fichier MIDI écrit");
+                for (const auto& other : contents)
+                    expect(other != data, "Voicings distincts");
+                contents.add(data);
+            }
+            
+            expect(result.enumerationStats.nodes > 0, "Statistiques d'énumération disponibles avec le résultat");
+            
+            folder.deleteRecursively();
+            logMessage(juce::String::fromUTF8("✓ Alternatives _altN.mid distinctes"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Incrémental : une section modifiée, les autres gardent leur voicing"));
+        {
+            auto folder = createTestFolder("diatony_incremental_test");
+            
+            Piece piece("Incremental");
+            addSectionWithChords(piece, Diatony::Note::C, cadence);
+            addSectionWithChords(piece, Diatony::Note::G, cadence);
+            
+            GenerationService service;
+            service.setCacheEnabled(false);
+            
+            expect(service.generateNow(piece, folder.getChildFile("first.mid").getFullPathName()).success, "1re solution");
+            const auto before = service.previousSolution.voicing;
+            
+            piece.getSection(1).getProgression().getChord(1).setDegree(Diatony::ChordDegree::Second);
+            auto result = service.generateNow(piece, folder.getChildFile("second.mid").getFullPathName());
+            const auto& after = service.previousSolution.voicing;
+            
+            expect(result.success, "Re-résolution réussie");
+            expect(result.pinnedChords >= 3, "Section 1 figée (sauf l'accord frontière)");
+            for (int chord = 0; chord < 3; ++chord)
+                expect(chordVoicing(after, chord) == chordVoicing(before, chord), "Accord " + juce::String(chord) + " conservé");
+            expectEquals(static_cast<int>(after.size()), static_cast<int>(before.size()), "Même nombre d'accords");
+            
+            folder.deleteRecursively();
+            logMessage(juce::String::fromUTF8("✓ Voicings des sections inchangées conservés"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Incrémental : repli sur la résolution complète"));
+        {
+            auto folder = createTestFolder("diatony_incremental_fallback_test");
+            
+            Piece piece("Fallback");
+            addSectionWithChords(piece, Diatony::Note::C, cadence);
+            
+            GenerationService service;
+            service.setCacheEnabled(false);
+            expect(service.generateNow(piece, folder.getChildFile("first.mid").getFullPathName()).success, "1re solution");
+            
+            // Notes hors tessiture : le problème figé est insatisfiable
+            std::fill(service.previousSolution.voicing.begin(), service.previousSolution.voicing.end(), 1);
+            
+            auto result = service.generateNow(piece, folder.getChildFile("second.mid").getFullPathName());
+            expect(result.success, "Solution trouvée par la résolution complète");
+            expectEquals(result.pinnedChords, 0, "Aucun accord figé dans la solution retenue");
+            expect(std::find(service.previousSolution.voicing.begin(), service.previousSolution.voicing.end(), 1)
+                       == service.previousSolution.voicing.end(), "Notes figées abandonnées");
+            
+            folder.deleteRecursively();
+            logMessage(juce::String::fromUTF8("✓ Repli si les notes figées sont insatisfiables"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Incrémental : recalage quand une section précédente change de taille"));
+        {
+            auto folder = createTestFolder("diatony_incremental_shift_test");
+            
+            Piece piece("Shift");
+            addSectionWithChords(piece, Diatony::Note::C, cadence);
+            addSectionWithChords(piece, Diatony::Note::G, cadence);
+            addSectionWithChords(piece, Diatony::Note::D, cadence);
+            
+            GenerationService service;
+            service.setCacheEnabled(false);
+            expect(service.generateNow(piece, folder.getChildFile("first.mid").getFullPathName()).success, "1re solution");
+            const auto original = service.previousSolution.voicing;
+            
+            // Section 1 grandit : la section 3 (inchangée) est décalée d'un accord
+            piece.getSection(0).getProgression().insertChord(0, Diatony::ChordDegree::First);
+            auto grown = service.generateNow(piece, folder.getChildFile("grown.mid").getFullPathName());
+            const auto afterGrowth = service.previousSolution.voicing;
+            
+            expect(grown.success, "Résolution après ajout");
+            expect(grown.pinnedChords > 0, "Section 3 figée");
+            for (int chord = 1; chord < 4; ++chord)
+                expect(chordVoicing(afterGrowth, 9 + chord) == chordVoicing(original, 8 + chord),
+                       "Section 3, accord " + juce::String(chord) + " recalé de +1");
+            
+            // Puis rétrécit : retour aux indices d'origine
+            piece.getSection(0).getProgression().removeChord(0);
+            auto shrunk = service.generateNow(piece, folder.getChildFile("shrunk.mid").getFullPathName());
+            
+            expect(shrunk.success, "Résolution après suppression");
+            expect(shrunk.pinnedChords > 0, "Section 3 toujours figée");
+            for (int chord = 1; chord < 4; ++chord)
+                expect(chordVoicing(service.previousSolution.voicing, 8 + chord) == chordVoicing(afterGrowth, 9 + chord),
+                       "Section 3, accord " + juce::String(chord) + " recalé de -1");
+            
+            folder.deleteRecursively();
+            logMessage(juce::String::fromUTF8("✓ Notes figées recalées sur les nouveaux indices globaux"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Mode anytime : trajectoire de coût et arrêt sur échéance"));
+        {
+            auto folder = createTestFolder("diatony_anytime_test");
+            
+            Piece piece("Anytime");
+            SyntheticPieceGenerator::Options options;
+            options.totalChords = 32;
+            SyntheticPieceGenerator::generate(piece, options);
+            
+            // Un seul thread : BAB déterministe, la recherche longue prolonge la courte
+            GenerationService service;
+            service.setCacheEnabled(false);
+            service.setIncrementalEnabled(false);
+            service.setPortfolioSize(1);
+            
+            GenerationBudget shortBudget;
+            shortBudget.optimiseForMs = 300;
+            auto shortRun = service.generateNow(piece, folder.getChildFile("short.mid").getFullPathName(), shortBudget);
+            
+            expect(shortRun.success, "Meilleure solution livrée à l'échéance");
+            expect(shortRun.optimised, "Issue du branch-and-bound");
+            expect(!shortRun.costTrajectory.empty(), "Au moins une solution enregistrée");
+            expect(folder.getChildFile("short.mid").existsAsFile(), "MIDI écrit");
+            expect(shortRun.stats.solveMs < shortBudget.optimiseForMs + 2000.0, "Recherche arrêtée par l'échéance");
+            
+            for (size_t i = 1; i < shortRun.costTrajectory.size(); ++i)
+            {
+                const auto& previous = shortRun.costTrajectory[i - 1];
+                const auto& current = shortRun.costTrajectory[i];
+                expect(current.cost < previous.cost, "Coût strictement décroissant (ordre lexicographique)");
+                expect(current.timeMs >= previous.timeMs, "Trajectoire chronologique");
+            }
+            
+            if (!shortRun.costTrajectory.empty())
+                expectWithinAbsoluteError(shortRun.timeToFirstSolutionMs, shortRun.costTrajectory.front().timeMs, 1.0e-6,
+                                          "1re solution = 1er point de la trajectoire");
+            
+            GenerationBudget longBudget;
+            longBudget.optimiseForMs = 1500;
+            auto longRun = service.generateNow(piece, folder.getChildFile("long.mid").getFullPathName(), longBudget);
+            
+            expect(longRun.success && !longRun.costTrajectory.empty(), "Recherche longue réussie");
+            if (!shortRun.costTrajectory.empty() && !longRun.costTrajectory.empty())
+                expect(!(shortRun.costTrajectory.back().cost < longRun.costTrajectory.back().cost),
+                       "Plus de temps ne dégrade jamais la solution retenue");
+            
+            folder.deleteRecursively();
+            logMessage(juce::String::fromUTF8("✓ ") + juce::String(static_cast<int>(shortRun.costTrajectory.size()))
+                       + juce::String::fromUTF8(" améliorations en 300 ms, ")
+                       + juce::String(static_cast<int>(longRun.costTrajectory.size())) + " en 1500 ms");
+        }
+        
+        beginTest(juce::String::fromUTF8("Statistiques de génération"));
+        {
+            GenerationStats a;
+            a.nodes = 100;
+            a.fails = 10;
+            a.peakDepth = 12;
+            
+            GenerationStats b;
+            b.nodes = 50;
+            b.fails = 5;
+            b.peakDepth = 20;
+            
+            a.solveMs = 4.0;
+            b.solveMs = 6.0;
+            a.peakMemoryBytes = 1000;
+            b.peakMemoryBytes = 3000;
+            
+            a.merge(b);
+            expectEquals((int) a.nodes, 150, "Nœuds sommés sur les workers");
+            expectEquals((int) a.fails, 15, "Échecs sommés");
+            expectEquals(a.peakDepth, 20, "Profondeur max conservée");
+            expectWithinAbsoluteError(a.solveMs, 10.0, 1.0e-9, "Temps de phase additionnés");
+            expect(a.peakMemoryBytes == 3000, "Pic mémoire maximal");
+            
+            a.solveMs = 12.5;
+            a.peakMemoryBytes = (juce::int64) 3 << 32;
+            auto xml = a.createXml();
+            expect(xml->hasTagName(GenerationStats::xmlTag), "Tag XML");
+            
+            auto restored = GenerationStats::fromXml(*xml);
+            expect(restored.nodes == a.nodes, "Aller-retour XML des nœuds");
+            expect(restored.peakMemoryBytes == a.peakMemoryBytes, "Aller-retour 64 bits");
+            expectWithinAbsoluteError(restored.solveMs, 12.5, 1.0e-9, "Aller-retour des temps");
+            
+            logMessage(juce::String::fromUTF8("✓ Statistiques fusionnées et sérialisées"));
+        }
+        
         beginTest(juce::String::fromUTF8("Reset du service"));
         {
             GenerationService service;
@@ -139,6 +504,35 @@ public:
             logMessage(juce::String::fromUTF8("✓ Reset fonctionne"));
         }
     }
+
+private:
+    const std::vector<Diatony::ChordDegree> cadence { Diatony::ChordDegree::First, Diatony::ChordDegree::Fourth,
+                                                      Diatony::ChordDegree::Fifth, Diatony::ChordDegree::First };
+    
+    static juce::File createTestFolder(const juce::String& name)
+    {
+        auto folder = juce::File::getSpecialLocation(juce::File::tempDirectory).getNonexistentChildFile(name, "");
+        folder.createDirectory();
+        return folder;
+    }
+    
+    static void addSectionWithChords(Piece& piece, Diatony::Note tonic, const std::vector<Diatony::ChordDegree>& degrees)
+    {
+        piece.addSection("Section " + juce::String(piece.getSectionCount() + 1));
+        auto section = piece.getSection(piece.getSectionCount() - 1);
+        section.setNote(tonic);
+        
+        auto progression = section.getProgression();
+        for (auto degree : degrees)
+            progression.addChord(degree);
+    }
+    
+    /** @brief Les 4 notes (basse → soprano) de l'accord d'indice global donné. */
+    static std::vector<int> chordVoicing(const std::vector<int>& voicing, int globalChordIndex)
+    {
+        const auto first = voicing.begin() + globalChordIndex * VoicingMidiWriter::voicesPerChord;
+        return { first, first + VoicingMidiWriter::voicesPerChord };
+    }
 };
 
 static GenerationServiceTest generationServiceTest;
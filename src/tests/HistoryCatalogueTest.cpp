@@ -0,0 +1,124 @@
+#include <JuceHeader.h>
+#include "services/HistoryCatalogue.h"
+#include "model/Piece.h"
+
+/** @brief Tests unitaires pour HistoryCatalogue (index persistant de l'historique). */
+class HistoryCatalogueTest : public juce::UnitTest
+{
+public:
+    HistoryCatalogueTest() : juce::UnitTest("HistoryCatalogue Tests", "history_tests") {}
+
+    void runTest() override
+    {
+        auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                             .getNonexistentChildFile("diatony_history_test", "");
+        directory.createDirectory();
+        auto indexFile = directory.getChildFile("catalogue.bin");
+
+        beginTest(juce::String::fromUTF8("Premier scan puis index réutilisé"));
+        {
+            writePiece(directory.getChildFile("a.diatony"), 2, juce::Time(2026, 0, 1, 10, 0));
+            writePiece(directory.getChildFile("b.diatony"), 3, juce::Time(2026, 0, 2, 10, 0));
+            writePiece(directory.getChildFile("c.diatony"), 1, juce::Time(2026, 0, 3, 10, 0));
+
+            HistoryCatalogue first(directory, indexFile);
+            expect(first.refresh(), "Contenu découvert");
+            expectEquals(first.getNumParsedFiles(), 3, "3 fichiers analysés");
+            expectEquals(static_cast<int>(first.getItems().size()), 3, "3 entrées");
+            expectEquals(first.getItems().front().name, juce::String("c"), "Plus récent en tête");
+            expectEquals(first.getItems()[1].numSections, 3, "Sections comptées");
+            expectEquals(first.getItems()[1].numModulations, 2, "Modulations comptées");
+            expect(indexFile.existsAsFile(), "Index écrit");
+
+            HistoryCatalogue reopened(directory, indexFile);
+            expect(!reopened.refresh(), "Rien de changé");
+            expectEquals(reopened.getNumParsedFiles(), 0, "Aucune analyse XML à la réouverture");
+            expectEquals(static_cast<int>(reopened.getItems().size()), 3, "Entrées relues depuis l'index");
+            expectEquals(reopened.getItems()[1].numChords, first.getItems()[1].numChords, "Métadonnées identiques");
+
+            logMessage(juce::String::fromUTF8("✓ Index persistant"));
+        }
+
+        beginTest(juce::String::fromUTF8("Revalidation sur date/taille et suppression"));
+        {
+            writePiece(directory.getChildFile("a.diatony"), 4, juce::Time(2026, 0, 4, 10, 0));
+            directory.getChildFile("b.diatony").deleteFile();
+
+            HistoryCatalogue catalogue(directory, indexFile);
+            expect(catalogue.refresh(), "Changements détectés");
+            expectEquals(catalogue.getNumParsedFiles(), 1, "Seul le fichier modifié est ré-analysé");
+            expectEquals(static_cast<int>(catalogue.getItems().size()), 2, "Fichier supprimé retiré");
+            expectEquals(catalogue.getItems().front().name, juce::String("a"), "a devient le plus récent");
+            expectEquals(catalogue.getItems().front().numSections, 4, "Nouvelles métadonnées");
+
+            logMessage(juce::String::fromUTF8("✓ Revalidation incrémentale"));
+        }
+
+        beginTest(juce::String::fromUTF8("Ajout d'un fichier écrit par une génération"));
+        {
+            HistoryCatalogue catalogue(directory, indexFile);
+            catalogue.refresh();
+
+            auto generated = directory.getChildFile("d.diatony");
+            writePiece(generated, 2, juce::Time::getCurrentTime());
+            expect(catalogue.addOrUpdate(generated), "Entrée ajoutée");
+            expectEquals(catalogue.getNumParsedFiles(), 1, "Une seule analyse");
+            expectEquals(catalogue.getItems().front().name, juce::String("d"), "Nouvelle solution en tête");
+            expect(!catalogue.addOrUpdate(directory.getChildFile("absent.diatony")), "Fichier absent ignoré");
+
+            HistoryCatalogue reopened(directory, indexFile);
+            expect(!reopened.refresh(), "Index déjà à jour");
+            expectEquals(static_cast<int>(reopened.getItems().size()), 3, "Ajout persisté");
+
+            logMessage(juce::String::fromUTF8("✓ Ajout incrémental"));
+        }
+
+        beginTest(juce::String::fromUTF8("Scan par lots, du plus récent au plus ancien"));
+        {
+            HistoryCatalogue catalogue(directory, indexFile);
+            directory.getChildFile("d.diatony").setLastModificationTime(juce::Time(2026, 0, 5, 10, 0));
+            writePiece(directory.getChildFile("e.diatony"), 1, juce::Time(2026, 0, 6, 10, 0));
+
+            juce::StringArray order;
+            int numBatches = 0;
+            auto outcome = HistoryCatalogue::scan(directory, {}, nullptr,
+                [&](std::vector<HistoryItem> batch)
+                {
+                    ++numBatches;
+                    for (const auto& item : batch)
+                        order.add(item.name);
+                }, 2);
+
+            expectEquals(order.joinIntoString(","), juce::String("e,d,a,c"), "Plus récents livrés d'abord");
+            expectEquals(numBatches, 2, "Lots de 2");
+            expectEquals(outcome.numParsed, 4, "Tout est analysé sans index");
+
+            int calls = 0;
+            auto cancelled = HistoryCatalogue::scan(directory, {}, [&calls] { return ++calls > 1; }, nullptr, 1);
+            expect(cancelled.cancelled, "Scan interrompu");
+            expectEquals(cancelled.numParsed, 1, "Arrêt avant la deuxième analyse");
+
+            const auto sizeBefore = catalogue.getStamps().size();
+            expect(!catalogue.finishScan(cancelled), "Scan interrompu : rien n'est retiré");
+            expectEquals(catalogue.getItems().size(), sizeBefore, "Entrées conservées");
+
+            logMessage(juce::String::fromUTF8("✓ Scan progressif et annulable"));
+        }
+
+        directory.deleteRecursively();
+    }
+
+private:
+    static void writePiece(const juce::File& file, int numSections, juce::Time modificationTime)
+    {
+        Piece piece("History");
+        for (int i = 0; i < numSections; ++i)
+            piece.addSection("S" + juce::String(i));
+
+        if (auto xml = piece.getState().createXml())
+            xml->writeTo(file);
+        file.setLastModificationTime(modificationTime);
+    }
+};
+
+static HistoryCatalogueTest historyCatalogueTest;
@@ -0,0 +1,150 @@
+#include <JuceHeader.h>
+#include "services/HistorySearchIndex.h"
+#include "model/DiatonyTypes.h"
+
+/** @brief Tests unitaires pour HistorySearchIndex et la syntaxe de recherche de l'historique. */
+class HistorySearchIndexTest : public juce::UnitTest
+{
+public:
+    HistorySearchIndexTest() : juce::UnitTest("HistorySearchIndex Tests", "history_tests") {}
+
+    void runTest() override
+    {
+        using Degree = Diatony::ChordDegree;
+        const int I = static_cast<int>(Degree::First);
+        const int II = static_cast<int>(Degree::Second);
+        const int IV = static_cast<int>(Degree::Fourth);
+        const int V = static_cast<int>(Degree::Fifth);
+        const int VofV = static_cast<int>(Degree::FiveOfFive);
+        const int cut = HistoryItem::sectionBreak;
+        const int pivot = 1 << static_cast<int>(Diatony::ModulationType::PivotChord);
+        const int chromatic = 1 << static_cast<int>(Diatony::ModulationType::Chromatic);
+
+        std::vector<HistoryItem> items;
+        items.push_back(makeItem("cadence_eb", 3, true, 1, 0, { I, IV, VofV, V, I }));
+        items.push_back(makeItem("split_c", 0, true, 2, pivot, { I, VofV, cut, V, I }));
+        items.push_back(makeItem("minor_a", 9, false, 3, pivot | chromatic, { I, II, V, I, cut, VofV, V, I, IV }));
+        items.push_back(makeItem("plain_c", 0, true, 1, 0, { I, IV, V, I }));
+
+        HistorySearchIndex index;
+        index.rebuild(items);
+
+        beginTest(juce::String::fromUTF8("Syntaxe de recherche"));
+        {
+            auto query = HistoryQuery::parse(juce::String::fromUTF8("Ebm  V/V → V → I s:2-4 pivot draft"));
+            expectEquals(query.note, 3, "Eb");
+            expectEquals(query.mode, 1, "Mineur");
+            expectEquals(static_cast<int>(query.degreeSequence.size()), 3, "Suite de 3 degrés");
+            expectEquals(query.degreeSequence.front(), VofV, "V/V");
+            expectEquals(query.minSections, 2);
+            expectEquals(query.maxSections, 4);
+            expectEquals(query.modulationTypeMask, pivot);
+            expect(query.nameTerms.contains("draft"), "Le reste filtre sur le nom");
+
+            auto reversed = HistoryQuery::parse("minor Eb");
+            expectEquals(reversed.note, 3, "Eb après le mode");
+            expectEquals(reversed.mode, 1, "La tonalité n'écrase pas le mode");
+            expectEquals(HistoryQuery::parse("Eb").mode, -1, "Sans suffixe : tous les modes");
+            expectEquals(HistoryQuery::parse("major Ebm").mode, 0, "Le mot-clé l'emporte sur le suffixe");
+
+            expectEquals(HistoryQuery::parseDegree(juce::String::fromUTF8("♭II")), static_cast<int>(Degree::FlatTwo));
+            expectEquals(HistoryQuery::parseDegree("ii"), II, "Minuscules acceptées");
+            expectEquals(HistoryQuery::parseDegree("Bach"), -1);
+            expect(HistoryQuery::parse("  ").isEmpty(), "Requête vide");
+            expectEquals(HistoryQuery::parse("ii-V-I").degreeSequence.size(), size_t(3), "Tirets acceptés");
+
+            logMessage(juce::String::fromUTF8("✓ Analyse de la requête"));
+        }
+
+        beginTest(juce::String::fromUTF8("Filtres par tonalité, mode, sections et modulations"));
+        {
+            expect(rows(index, "C") == std::vector<int>{ 1, 3 }, "Do majeur");
+            expect(rows(index, "minor") == std::vector<int>{ 2 }, "Mineur");
+            expect(rows(index, "minor A") == std::vector<int>{ 2 }, "Mode puis tonalité");
+            expect(rows(index, "Am") == std::vector<int>{ 2 }, "Suffixe mineur");
+            expect(rows(index, "s:2-") == std::vector<int>{ 1, 2 }, "Au moins 2 sections");
+            expect(rows(index, "pivot chromatic") == std::vector<int>{ 2 }, "Tous les types demandés");
+            expect(rows(index, "plain") == std::vector<int>{ 3 }, "Nom");
+            expect(rows(index, "").size() == items.size(), "Sans critère : tout");
+
+            logMessage(juce::String::fromUTF8("✓ Filtres simples"));
+        }
+
+        beginTest(juce::String::fromUTF8("Suites de degrés"));
+        {
+            expect(rows(index, "V/V>V>I") == std::vector<int>{ 0, 2 }, "Suite contiguë");
+            expect(rows(index, "V/V>V") == std::vector<int>{ 0, 2 }, "Bigramme ; pas à cheval sur deux sections");
+            expect(rows(index, "IV>V/V>V>I") == std::vector<int>{ 0 }, "Plus de 3 degrés : vérification");
+            expect(rows(index, "I>V/V>V>I").empty(), "Ordre respecté");
+            expect(rows(index, "C V>I") == std::vector<int>{ 1, 3 }, "Combiné avec la tonalité");
+
+            logMessage(juce::String::fromUTF8("✓ N-grammes de degrés"));
+        }
+
+        beginTest(juce::String::fromUTF8("Requêtes sur 100k entrées"));
+        {
+            juce::Random random(42);
+            std::vector<HistoryItem> many;
+            many.reserve(100000);
+
+            for (int i = 0; i < 100000; ++i)
+            {
+                std::vector<int> degrees;
+                const int sections = 1 + random.nextInt(4);
+                for (int s = 0; s < sections; ++s)
+                {
+                    if (s > 0)
+                        degrees.push_back(cut);
+                    for (int c = 0; c < 8; ++c)
+                        degrees.push_back(random.nextInt(14));
+                }
+                many.push_back(makeItem("solution_" + juce::String(i), random.nextInt(12), random.nextBool(),
+                                        sections, random.nextInt(16), degrees));
+            }
+
+            HistorySearchIndex large;
+            auto buildStart = juce::Time::getMillisecondCounterHiRes();
+            large.rebuild(many);
+            const auto buildMs = juce::Time::getMillisecondCounterHiRes() - buildStart;
+
+            double worstMs = 0.0;
+            for (auto text : { "V/V>V>I", "Eb minor", "s:2-3 pivot", "G V>I", "IV>V/V>V>I" })
+            {
+                const auto query = HistoryQuery::parse(text);
+                auto start = juce::Time::getMillisecondCounterHiRes();
+                auto found = large.search(query);
+                worstMs = juce::jmax(worstMs, juce::Time::getMillisecondCounterHiRes() - start);
+                expect(!found.empty(), juce::String("Résultats pour ") + text);
+            }
+
+            logMessage(juce::String::fromUTF8("✓ Index 100k construit en ") + juce::String(buildMs, 1)
+                       + " ms, pire requête " + juce::String(worstMs, 2) + " ms");
+        }
+    }
+
+private:
+    static HistoryItem makeItem(const juce::String& name, int note, bool isMajor, int sections,
+                                int modulationMask, const std::vector<int>& degrees)
+    {
+        HistoryItem item;
+        item.name = name;
+        item.startNote = note;
+        item.startIsMajor = isMajor;
+        item.numSections = sections;
+        item.modulationTypeMask = modulationMask;
+
+        for (int degree : degrees)
+        {
+            const auto code = static_cast<juce::uint8>(degree);
+            item.chordDegrees.append(&code, 1);
+        }
+        return item;
+    }
+
+    static std::vector<int> rows(const HistorySearchIndex& index, const juce::String& text)
+    {
+        return index.search(HistoryQuery::parse(text));
+    }
+};
+
+static HistorySearchIndexTest historySearchIndexTest;
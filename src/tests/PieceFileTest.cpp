@@ -0,0 +1,91 @@
+#include <JuceHeader.h>
+#include "model/PieceFile.h"
+#include "model/Piece.h"
+
+/** @brief Tests unitaires pour PieceFile (format binaire .diatony, import/export XML). */
+class PieceFileTest : public juce::UnitTest
+{
+public:
+    PieceFileTest() : juce::UnitTest("PieceFile Tests", "piecefile_tests") {}
+
+    void runTest() override
+    {
+        Piece piece("Binary");
+        piece.addSection("A");
+        piece.addSection("B");
+        piece.getSection(0).setNote(Diatony::Note::DSharp);
+        piece.getSection(0).setIsMajor(false);
+        piece.getSection(0).getProgression().addChord(Diatony::ChordDegree::First);
+        piece.getSection(0).getProgression().addChord(Diatony::ChordDegree::FiveOfFive);
+        piece.getSection(1).getProgression().addChord(Diatony::ChordDegree::Fifth);
+        piece.getModulation(0).setModulationType(Diatony::ModulationType::Chromatic);
+
+        juce::ValueTree metadata(PieceFile::metadataType);
+        metadata.appendChild(juce::ValueTree("GenerationStats").setProperty("solveMs", 12.5, nullptr), nullptr);
+
+        beginTest(juce::String::fromUTF8("Aller-retour binaire"));
+        {
+            juce::TemporaryFile file(".diatony");
+            expect(PieceFile::write(piece.getState(), file.getFile(), metadata), "Écriture");
+            expect(PieceFile::isBinary(file.getFile()), "Format binaire");
+
+            juce::ValueTree readMetadata;
+            auto state = PieceFile::read(file.getFile(), &readMetadata);
+            expect(state.isEquivalentTo(piece.getState()), "Arbre identique");
+            expect(readMetadata.isEquivalentTo(metadata), "Métadonnées séparées de la pièce");
+
+            logMessage(juce::String::fromUTF8("✓ Écriture et relecture binaires"));
+        }
+
+        beginTest(juce::String::fromUTF8("Résumé lu depuis l'en-tête seul"));
+        {
+            juce::TemporaryFile file(".diatony");
+            PieceFile::write(piece.getState(), file.getFile(), metadata);
+
+            PieceFile::Summary summary;
+            expect(PieceFile::readSummary(file.getFile(), summary), "Résumé lisible");
+            expectEquals(summary.startNote, static_cast<int>(Diatony::Note::DSharp));
+            expect(!summary.startIsMajor, "Mineur");
+            expectEquals(summary.numSections, 2);
+            expectEquals(summary.numModulations, 1);
+            expectEquals(summary.numChords, 3);
+            expectEquals(summary.modulationTypeMask, 1 << static_cast<int>(Diatony::ModulationType::Chromatic));
+            expectEquals(static_cast<int>(summary.chordDegrees.getSize()), 4, "3 degrés + 1 séparateur");
+            expectEquals(static_cast<int>(summary.chordDegrees[2]), static_cast<int>(PieceFile::sectionBreak));
+
+            // Arbre tronqué : le résumé n'en dépend pas, le chargement échoue proprement
+            juce::MemoryBlock data;
+            file.getFile().loadFileAsData(data);
+            const auto headerAndDegrees = static_cast<size_t>(PieceFile::headerSize) + summary.chordDegrees.getSize();
+            juce::MemoryBlock truncated(data.getData(), headerAndDegrees + 4);
+            file.getFile().replaceWithData(truncated.getData(), truncated.getSize());
+
+            expect(!PieceFile::read(file.getFile()).isValid(), "Fichier tronqué refusé");
+            PieceFile::Summary unused;
+            expect(!PieceFile::readSummary(file.getFile(), unused), "Longueur vérifiée");
+
+            logMessage(juce::String::fromUTF8("✓ En-tête de résumé"));
+        }
+
+        beginTest(juce::String::fromUTF8("Import et export XML"));
+        {
+            juce::TemporaryFile file(".diatony");
+            expect(PieceFile::writeXml(piece.getState(), file.getFile(), metadata), "Export XML");
+            expect(!PieceFile::isBinary(file.getFile()), "Texte");
+            expect(juce::XmlDocument::parse(file.getFile()) != nullptr, "XML lisible");
+
+            juce::ValueTree readMetadata;
+            auto state = PieceFile::read(file.getFile(), &readMetadata);
+            expect(state.isEquivalentTo(piece.getState()), "Import XML identique");
+            expectEquals(readMetadata.getNumChildren(), 1, "Statistiques extraites de l'arbre");
+
+            PieceFile::Summary summary;
+            expect(PieceFile::readSummary(file.getFile(), summary), "Résumé depuis le XML");
+            expectEquals(summary.numChords, 3);
+
+            logMessage(juce::String::fromUTF8("✓ Chemin XML conservé"));
+        }
+    }
+};
+
+static PieceFileTest pieceFileTest;
@@ -0,0 +1,257 @@
+#include <JuceHeader.h>
+#include "model/Piece.h"
+#include "model/SyntheticPieceGenerator.h"
+#include "model/ChordOffsetTree.h"
+#include "model/DiatonyTypes.h"
+
+/** @brief Tests unitaires pour PieceIndex (accès O(1) de Piece, synchronisé par listener). */
+class PieceIndexTest : public juce::UnitTest
+{
+public:
+    PieceIndexTest() : juce::UnitTest("PieceIndex Tests", "model_index_tests") {}
+
+    void runTest() override
+    {
+        beginTest(juce::String::fromUTF8("Rang, id et décalages après ajouts"));
+        {
+            Piece piece("Index");
+            piece.addSection("A");
+            piece.addSection("B");
+            piece.addSection("C");
+
+            addChords(piece.getSection(0), 3);
+            addChords(piece.getSection(1), 2);
+            addChords(piece.getSection(2), 4);
+
+            expectEquals(static_cast<int>(piece.getSectionCount()), 3, "3 sections");
+            expectEquals(static_cast<int>(piece.getModulationCount()), 2, "2 modulations");
+            expectEquals(piece.getTotalChordCount(), 9, "9 accords");
+            expectEquals(piece.getSectionChordOffset(1), 3, "B commence à 3");
+            expectEquals(piece.getSectionChordOffset(2), 5, "C commence à 5");
+
+            const int idB = piece.getSection(1).getId();
+            expectEquals(piece.getSectionIndexById(idB), 1, "Rang depuis l'id");
+            expect(piece.getSectionById(idB).getState() == piece.getSection(1).getState(), "Même nœud par id et par rang");
+
+            logMessage(juce::String::fromUTF8("✓ Index construit"));
+        }
+
+        beginTest(juce::String::fromUTF8("Suppression d'accords et de sections"));
+        {
+            Piece piece("Edits");
+            piece.addSection("A");
+            piece.addSection("B");
+            piece.addSection("C");
+            addChords(piece.getSection(0), 3);
+            addChords(piece.getSection(1), 3);
+            addChords(piece.getSection(2), 3);
+
+            expectEquals(piece.getSectionChordOffset(2), 6, "Décalage initial");
+
+            piece.getSection(0).getProgression().removeChord(0);
+            expectEquals(piece.getSectionChordOffset(2), 5, "Décalage mis à jour après retrait d'accord");
+            expectEquals(piece.getTotalChordCount(), 8, "Total mis à jour");
+
+            const int idC = piece.getSection(2).getId();
+            piece.getUndoManager().beginNewTransaction();
+            piece.removeSection(1);
+            expectEquals(static_cast<int>(piece.getSectionCount()), 2, "Section du milieu supprimée");
+            expectEquals(piece.getSectionIndexById(idC), 1, "C passe au rang 1");
+            expectEquals(piece.getSectionChordOffset(1), 2, "C commence après A");
+            expectEquals(static_cast<int>(piece.getModulationCount()), 1, "Modulation de liaison recréée");
+
+            piece.getUndoManager().undo();
+            expectEquals(static_cast<int>(piece.getSectionCount()), 3, "Undo : section restaurée");
+            expectEquals(piece.getSectionIndexById(idC), 2, "Undo : C revient au rang 2");
+
+            logMessage(juce::String::fromUTF8("✓ Index suit les éditions et l'undo"));
+        }
+
+        beginTest(juce::String::fromUTF8("Remplacement complet de l'arbre"));
+        {
+            SyntheticPieceGenerator::Options options;
+            options.totalChords = 120;
+
+            Piece source;
+            SyntheticPieceGenerator::generate(source, options);
+
+            Piece piece("Target");
+            piece.addSection("Old");
+            piece.getState().copyPropertiesAndChildrenFrom(source.getState(), nullptr);
+
+            expectEquals(static_cast<int>(piece.getSectionCount()), static_cast<int>(source.getSectionCount()), "Sections copiées");
+            expectEquals(piece.getTotalChordCount(), 120, "Accords copiés");
+
+            int expectedOffset = 0;
+            for (size_t s = 0; s < piece.getSectionCount(); ++s)
+            {
+                expectEquals(piece.getSectionChordOffset(s), expectedOffset, "Décalage cumulé");
+                expectedOffset += static_cast<int>(piece.getSection(s).getProgression().size());
+            }
+
+            piece.clear();
+            expectEquals(static_cast<int>(piece.getSectionCount()), 0, "Pièce vidée");
+            expectEquals(piece.getTotalChordCount(), 0, "Plus d'accords");
+
+            logMessage(juce::String::fromUTF8("✓ Index reconstruit après remplacement"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Arbre de Fenwick des décalages d'accords"));
+        {
+            juce::Random random(7);
+            ChordOffsetTree tree;
+            std::vector<int> reference;
+            
+            for (int step = 0; step < 500; ++step)
+            {
+                const int operation = random.nextInt(4);
+                
+                if (operation == 0 || reference.empty())
+                {
+                    reference.push_back(random.nextInt(6));
+                    tree.pushBack(reference.back());
+                }
+                else if (operation == 1)
+                {
+                    reference.pop_back();
+                    tree.popBack();
+                }
+                else
+                {
+                    const int section = random.nextInt(static_cast<int>(reference.size()));
+                    const int delta = reference[static_cast<size_t>(section)] > 0 && random.nextBool() ? -1 : 1;
+                    reference[static_cast<size_t>(section)] += delta;
+                    tree.add(section, delta);
+                }
+            }
+            
+            int offset = 0;
+            bool offsetsMatch = true, locationsMatch = true;
+            for (size_t s = 0; s < reference.size(); ++s)
+            {
+                offsetsMatch &= tree.getOffset(static_cast<int>(s)) == offset;
+                for (int c = 0; c < reference[s]; ++c)
+                    locationsMatch &= tree.findSection(offset + c) == static_cast<int>(s);
+                offset += reference[s];
+            }
+            
+            expect(offsetsMatch, "Préfixes identiques à la somme naïve");
+            expect(locationsMatch, "Recherche inverse correcte (sections vides sautées)");
+            expectEquals(tree.getTotal(), offset, "Total");
+            expectEquals(tree.findSection(offset), -1, "Hors bornes");
+            
+            ChordOffsetTree rebuilt;
+            rebuilt.build(reference);
+            expectEquals(rebuilt.getOffset(static_cast<int>(reference.size()) / 2),
+                         tree.getOffset(static_cast<int>(reference.size()) / 2), "build() équivaut aux ajouts successifs");
+            
+            logMessage(juce::String::fromUTF8("✓ Fenwick conforme à la référence"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Indice global ↔ (section, accord)"));
+        {
+            Piece piece("Locate");
+            piece.addSection("A");
+            piece.addSection("B");
+            piece.addSection("C");
+            addChords(piece.getSection(0), 2);
+            addChords(piece.getSection(2), 3);
+            
+            expectEquals(piece.getGlobalChordIndex(2, 1), 3, "C[1] est l'accord global 3");
+            
+            auto location = piece.getChordLocation(2);
+            expectEquals(location.first, 2, "Accord 2 dans C (B est vide)");
+            expectEquals(location.second, 0, "Premier accord de C");
+            expectEquals(piece.getChordLocation(5).first, -1, "Hors bornes");
+            
+            addChords(piece.getSection(1), 1);
+            expectEquals(piece.getChordLocation(2).first, 1, "Après ajout dans B");
+            
+            logMessage(juce::String::fromUTF8("✓ Conversions globales"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Compteurs d'IDs monotones"));
+        {
+            Piece piece("Ids");
+            piece.addSection("A");
+            piece.addSection("B");
+            piece.addSection("C");
+            
+            piece.removeLastSection();
+            piece.addSection("D");
+            expectEquals(piece.getSection(2).getId(), 3, "ID de la section supprimée non réutilisé");
+            expectEquals(static_cast<int>(piece.getState().getProperty(ModelIdentifiers::nextModulationId)), 3,
+                         "Une seule allocation par modulation");
+            
+            auto progression = piece.getSection(0).getProgression();
+            addChords(piece.getSection(0), 3);
+            progression.removeChord(2);
+            progression.addChord(Diatony::ChordDegree::Fifth);
+            expectEquals(progression.getChord(2).getId(), 3, "ID d'accord non réutilisé");
+            
+            logMessage(juce::String::fromUTF8("✓ Allocation sans balayage"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Compteurs persistés et restaurés au chargement"));
+        {
+            Piece source("Source");
+            source.addSection("A");
+            source.addSection("B");
+            addChords(source.getSection(1), 2);
+            source.removeLastSection();
+            
+            // Aller-retour XML, comme un .diatony
+            auto xml = source.getState().createXml();
+            Piece loaded;
+            loaded.getState().copyPropertiesAndChildrenFrom(juce::ValueTree::fromXml(*xml), nullptr);
+            loaded.restoreIdCounters();
+            loaded.addSection("C");
+            expectEquals(loaded.getSection(1).getId(), 2, "Compteur relu depuis le fichier");
+            
+            // Ancien fichier sans compteurs : recalés sur les IDs présents
+            auto legacy = juce::ValueTree::fromXml(*xml);
+            legacy.removeProperty(ModelIdentifiers::nextSectionId, nullptr);
+            legacy.removeProperty(ModelIdentifiers::nextModulationId, nullptr);
+            Piece old;
+            old.getState().copyPropertiesAndChildrenFrom(legacy, nullptr);
+            old.restoreIdCounters();
+            expectEquals(static_cast<int>(old.getState().getProperty(ModelIdentifiers::nextSectionId)), 1, "Compteur restauré");
+            old.addSection("C");
+            expectEquals(old.getSection(1).getId(), 1, "Suite des IDs présents");
+            
+            logMessage(juce::String::fromUTF8("✓ Compteurs persistés"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Accord par ID via l'index"));
+        {
+            Piece piece("Chords");
+            piece.addSection("A");
+            piece.addSection("B");
+            addChords(piece.getSection(1), 4);
+            
+            const int sectionId = piece.getSection(1).getId();
+            auto progression = piece.getSection(1).getProgression();
+            expectEquals(piece.getChordIndexById(sectionId, 3), 3, "Rang initial");
+            
+            progression.removeChord(0);
+            expectEquals(piece.getChordIndexById(sectionId, 3), 2, "Table invalidée après retrait");
+            expectEquals(piece.getChordIndexById(sectionId, 0), -1, "Accord retiré inconnu");
+            
+            progression.insertChord(0, Diatony::ChordDegree::Second);
+            expect(piece.getChordById(sectionId, 4).getState() == progression.getChord(0).getState(), "Accord inséré retrouvé");
+            expectEquals(progression.getChordIndexById(4), 0, "Repli par balayage dans Progression");
+            
+            logMessage(juce::String::fromUTF8("✓ Accords retrouvés par ID"));
+        }
+    }
+
+private:
+    static void addChords(Section section, int count)
+    {
+        auto progression = section.getProgression();
+        for (int i = 0; i < count; ++i)
+            progression.addChord(Diatony::ChordDegree::First);
+    }
+};
+
+static PieceIndexTest pieceIndexTest;
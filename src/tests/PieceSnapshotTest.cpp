@@ -0,0 +1,92 @@
+#include <JuceHeader.h>
+#include "model/Piece.h"
+#include "model/PieceSnapshot.h"
+#include "model/DiatonyTypes.h"
+
+/** @brief Tests unitaires pour PieceSnapshot (instantané aplati transmis au solveur). */
+class PieceSnapshotTest : public juce::UnitTest
+{
+public:
+    PieceSnapshotTest() : juce::UnitTest("PieceSnapshot Tests", "snapshot_tests") {}
+    
+    void runTest() override
+    {
+        beginTest(juce::String::fromUTF8("Pièce vide"));
+        {
+            Piece piece("Empty");
+            PieceSnapshot snapshot(piece);
+            
+            expect(snapshot.isEmpty(), "Instantané vide");
+            expectEquals(snapshot.getTitle(), juce::String("Empty"), "Titre copié");
+            expectEquals(snapshot.getTotalChordCount(), 0, "Aucun accord");
+            
+            logMessage(juce::String::fromUTF8("✓ Pièce vide"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Sections, accords et indices globaux"));
+        {
+            Piece piece("Two Sections");
+            piece.addSection("A");
+            piece.addSection("B");
+            
+            auto sectionA = piece.getSection(0);
+            sectionA.setNote(Diatony::Note::D);
+            auto progressionA = sectionA.getProgression();
+            progressionA.addChord(Diatony::ChordDegree::First, Diatony::ChordQuality::Auto, Diatony::ChordState::Fundamental);
+            progressionA.addChord(Diatony::ChordDegree::Fifth, Diatony::ChordQuality::DominantSeventh, Diatony::ChordState::FirstInversion);
+            
+            auto sectionB = piece.getSection(1);
+            sectionB.setIsMajor(false);
+            auto progressionB = sectionB.getProgression();
+            progressionB.addChord(Diatony::ChordDegree::Fourth, Diatony::ChordQuality::Minor, Diatony::ChordState::Fundamental);
+            progressionB.addChord(Diatony::ChordDegree::Fifth, Diatony::ChordQuality::Auto, Diatony::ChordState::Fundamental);
+            progressionB.addChord(Diatony::ChordDegree::First, Diatony::ChordQuality::Auto, Diatony::ChordState::Fundamental);
+            
+            PieceSnapshot snapshot(piece);
+            
+            expectEquals(snapshot.getSectionCount(), 2, "2 sections");
+            expectEquals(snapshot.getModulationCount(), 1, "1 modulation");
+            expectEquals(snapshot.getTotalChordCount(), 5, "5 accords");
+            
+            expectEquals(snapshot.getSection(0).tonic, static_cast<int>(Diatony::Note::D), "Tonique D");
+            expect(snapshot.getSection(0).isMajor, "Section A majeure");
+            expect(!snapshot.getSection(1).isMajor, "Section B mineure");
+            
+            expectEquals(snapshot.getSection(0).firstChordIndex, 0, "A commence à 0");
+            expectEquals(snapshot.getSection(1).firstChordIndex, 2, "B commence à 2");
+            expectEquals(snapshot.getSection(1).chordCount, 3, "B contient 3 accords");
+            
+            const auto& chord = snapshot.getChord(1);
+            expectEquals(chord.degree, static_cast<int>(Diatony::ChordDegree::Fifth), "Degré V");
+            expectEquals(chord.quality, static_cast<int>(Diatony::ChordQuality::DominantSeventh), "Qualité V7");
+            expectEquals(chord.state, static_cast<int>(Diatony::ChordState::FirstInversion), "1er renversement");
+            expectEquals(snapshot.getChord(0).quality, static_cast<int>(Diatony::ChordQuality::Auto), "Auto conservé");
+            
+            const auto& modulation = snapshot.getModulation(0);
+            expectEquals(modulation.fromSectionIndex, 0, "Modulation depuis la section 0");
+            expectEquals(modulation.toSectionIndex, 1, "Modulation vers la section 1");
+            
+            logMessage(juce::String::fromUTF8("✓ Instantané aplati cohérent"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Indépendance vis-à-vis du modèle vivant"));
+        {
+            Piece piece;
+            piece.addSection("A");
+            auto progression = piece.getSection(0).getProgression();
+            progression.addChord(Diatony::ChordDegree::First, Diatony::ChordQuality::Major, Diatony::ChordState::Fundamental);
+            
+            PieceSnapshot snapshot(piece);
+            
+            progression.addChord(Diatony::ChordDegree::Fifth, Diatony::ChordQuality::Major, Diatony::ChordState::Fundamental);
+            piece.getSection(0).getProgression().getChord(0).setDegree(Diatony::ChordDegree::Sixth);
+            
+            expectEquals(snapshot.getTotalChordCount(), 1, "Accord ajouté après coup ignoré");
+            expectEquals(snapshot.getChord(0).degree, static_cast<int>(Diatony::ChordDegree::First), "Modification ignorée");
+            
+            logMessage(juce::String::fromUTF8("✓ Instantané immuable"));
+        }
+    }
+};
+
+static PieceSnapshotTest pieceSnapshotTest;
@@ -188,6 +188,43 @@ public:
             
             logMessage(juce::String::fromUTF8("✓ Section unique supprimée"));
         }
+        
+        beginTest(juce::String::fromUTF8("Lot d'éditions : une transaction, une notification"));
+        {
+            struct CountingListener : Piece::Listener
+            {
+                int notifications = 0;
+                bool sawBatchOpen = false;
+                void pieceEditBatchEnded(Piece& p) override { ++notifications; sawBatchOpen |= p.isInEditBatch(); }
+            };
+            
+            Piece piece;
+            piece.addSection("Base");
+            piece.getUndoManager().beginNewTransaction();
+            
+            CountingListener listener;
+            piece.addListener(&listener);
+            {
+                Piece::ScopedEditBatch batch(piece, "Paste");
+                for (int i = 0; i < 8; ++i)
+                {
+                    Piece::ScopedEditBatch nested(piece);
+                    piece.addSection("S" + juce::String(i));
+                }
+                expect(piece.isInEditBatch(), "Lot ouvert");
+                expectEquals(listener.notifications, 0, "Aucune notification pendant le lot");
+            }
+            
+            expectEquals(listener.notifications, 1, "Une seule notification en fin de lot");
+            expect(!listener.sawBatchOpen, "Lot fermé au moment de la notification");
+            expectEquals(static_cast<int>(piece.getSectionCount()), 9, "9 sections");
+            
+            piece.getUndoManager().undo();
+            expectEquals(static_cast<int>(piece.getSectionCount()), 1, "Un seul undo annule tout le lot");
+            piece.removeListener(&listener);
+            
+            logMessage(juce::String::fromUTF8("✓ Lot d'éditions coalescé"));
+        }
     }
 };
 
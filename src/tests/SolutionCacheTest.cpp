@@ -0,0 +1,230 @@
+#include <JuceHeader.h>
+#include "services/SolutionCache.h"
+#include "services/PersistentSolutionCache.h"
+#include "services/VoicingMidiWriter.h"
+
+/** @brief Tests unitaires pour SolutionCache (clé canonique, hits/misses, éviction). */
+class SolutionCacheTest : public juce::UnitTest
+{
+public:
+    SolutionCacheTest() : juce::UnitTest("SolutionCache Tests", "cache_tests") {}
+    
+    void runTest() override
+    {
+        beginTest(juce::String::fromUTF8("Clé stable et sensible au contenu"));
+        {
+            auto makeKey = [](const std::vector<int>& degrees, int tonic)
+            {
+                SolutionCache::KeyBuilder builder;
+                builder.add(tonic);
+                builder.add(true);
+                builder.add(degrees);
+                return builder.finish();
+            };
+            
+            auto key = makeKey({ 0, 3, 4, 0 }, 0);
+            
+            expect(key == makeKey({ 0, 3, 4, 0 }, 0), "Même problème → même clé");
+            expect(key != makeKey({ 0, 4, 3, 0 }, 0), "Ordre des degrés pris en compte");
+            expect(key != makeKey({ 0, 3, 4, 0 }, 2), "Tonalité prise en compte");
+            expectEquals(key.toString().length(), 32, "128 bits en hexadécimal");
+            
+            SolutionCache::KeyBuilder a, b;
+            a.add(std::vector<int> { 1, 2 }); a.add(std::vector<int> { 3 });
+            b.add(std::vector<int> { 1 });    b.add(std::vector<int> { 2, 3 });
+            expect(a.finish() != b.finish(), "Longueurs préfixées : pas de collision triviale");
+            
+            logMessage(juce::String::fromUTF8("✓ Clé canonique"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Hits et misses"));
+        {
+            SolutionCache cache;
+            SolutionCache::KeyBuilder builder;
+            builder.add(42);
+            auto key = builder.finish();
+            
+            std::vector<int> voicing;
+            expect(!cache.lookup(key, voicing), "Miss initial");
+            
+            cache.store(key, { 48, 55, 64, 72 });
+            expect(cache.lookup(key, voicing), "Hit après stockage");
+            expectEquals(static_cast<int>(voicing.size()), 4, "Voicing restitué");
+            expectEquals(voicing[3], 72, "Soprano restitué");
+            
+            auto stats = cache.getStats();
+            expectEquals(stats.hits, 1, "1 hit");
+            expectEquals(stats.misses, 1, "1 miss");
+            expectEquals(stats.entries, 1, "1 entrée");
+            
+            logMessage(juce::String::fromUTF8("✓ Statistiques du cache"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Éviction au-delà de maxEntries"));
+        {
+            SolutionCache cache;
+            SolutionCache::ProblemKey firstKey;
+            
+            for (int i = 0; i <= SolutionCache::maxEntries; ++i)
+            {
+                SolutionCache::KeyBuilder builder;
+                builder.add(i);
+                auto key = builder.finish();
+                if (i == 0)
+                    firstKey = key;
+                cache.store(key, { 60, 64, 67, 72 });
+            }
+            
+            std::vector<int> voicing;
+            expectEquals(cache.getStats().entries, SolutionCache::maxEntries, "Taille bornée");
+            expect(!cache.lookup(firstKey, voicing), "Entrée la plus ancienne évincée");
+            
+            logMessage(juce::String::fromUTF8("✓ Éviction FIFO"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Cache persistant partagé entre instances"));
+        {
+            auto file = juce::File::createTempFile(".bin");
+            
+            SolutionCache::KeyBuilder builder;
+            builder.add(7);
+            auto key = builder.finish();
+            std::vector<int> voicing;
+            
+            {
+                PersistentSolutionCache writer(file);
+                expect(!writer.lookup(key, voicing), "Fichier absent → miss");
+                expect(writer.append(key, { 48, 55, 64, 72 }), "Ajout réussi");
+                expect(writer.lookup(key, voicing), "Relu après ajout");
+            }
+            
+            // Nouvelle instance (autre session / autre plugin) : relit le fichier mappé
+            SolutionCache cache;
+            cache.attachPersistentStore(file);
+            expect(cache.lookup(key, voicing), "Hit depuis le disque");
+            expectEquals(voicing[0], 48, "Basse restituée");
+            expectEquals(cache.getStats().diskHits, 1, "Hit disque compté");
+            
+            // Fin tronquée (crash pendant l'écriture) : ignorée, puis écrasée au prochain ajout
+            {
+                juce::FileOutputStream out(file);
+                out.writeInt64(123);
+            }
+            
+            PersistentSolutionCache recovered(file);
+            expect(recovered.lookup(key, voicing), "Enregistrements valides toujours lisibles");
+            
+            SolutionCache::KeyBuilder otherBuilder;
+            otherBuilder.add(8);
+            auto otherKey = otherBuilder.finish();
+            expect(recovered.append(otherKey, { 43, 55, 62, 71 }), "Ajout après réparation");
+            expect(recovered.lookup(otherKey, voicing), "Nouvel enregistrement lisible");
+            expectEquals(recovered.getNumIndexedEntries(), 2, "2 enregistrements indexés");
+            
+            file.deleteFile();
+            logMessage(juce::String::fromUTF8("✓ Cache persistant"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Fichier tronqué par une autre instance sous un mapping actif"));
+        {
+            auto file = juce::File::createTempFile(".bin");
+            
+            SolutionCache::KeyBuilder builder;
+            builder.add(9);
+            auto key = builder.finish();
+            std::vector<int> voicing;
+            
+            PersistentSolutionCache reader(file);
+            expect(reader.append(key, { 48, 55, 64, 72 }), "Ajout");
+            expect(reader.lookup(key, voicing), "Hit via le mapping");
+            
+            // Recréé ailleurs avec seulement l'en-tête : relire l'ancien mapping provoquerait un SIGBUS
+            {
+                juce::FileOutputStream out(file);
+                out.setPosition(PersistentSolutionCache::headerSize);
+                out.truncate();
+            }
+            
+            expect(!reader.lookup(key, voicing), "Taille revérifiée : défaut de cache, pas de lecture hors fichier");
+            expectEquals(reader.getNumIndexedEntries(), 0, "Index réinitialisé");
+            expect(reader.append(key, { 43, 55, 62, 71 }), "Réécriture possible");
+            expect(reader.lookup(key, voicing) && voicing[0] == 43, "Nouvel enregistrement lu");
+            
+            file.deleteFile();
+            logMessage(juce::String::fromUTF8("✓ Troncature détectée avant lecture"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Écriture MIDI d'un voicing"));
+        {
+            auto file = juce::File::createTempFile(".mid");
+            juce::String error;
+            
+            expect(VoicingMidiWriter::write({ 48, 55, 64, 72, 43, 55, 62, 71 }, file, error), "Écriture réussie");
+            expect(file.getSize() > 0, "Fichier non vide");
+            expect(!VoicingMidiWriter::write({ 48, 55, 64 }, file, error), "Voicing incomplet refusé");
+            
+            file.deleteFile();
+            logMessage(juce::String::fromUTF8("✓ VoicingMidiWriter"));
+        }
+        
+        beginTest(juce::String::fromUTF8("Écriture MIDI : disposition de référence"));
+        {
+            auto file = juce::File::createTempFile(".mid");
+            juce::String error;
+            expect(VoicingMidiWriter::write({ 48, 55, 64, 72, 43, 55, 62, 71 }, file, error), "Écriture réussie");
+            
+            // En-tête attendu : MThd, format 1, une piste, 480 ticks par noire
+            juce::MemoryBlock data;
+            file.loadFileAsData(data);
+            const juce::uint8 expectedHeader[] = { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, 1, 0x01, 0xE0 };
+            expect(data.getSize() > sizeof(expectedHeader)
+                   && std::memcmp(data.getData(), expectedHeader, sizeof(expectedHeader)) == 0, "En-tête de référence");
+            
+            // Événements de référence (tick, octets) : toute modification de la sortie MIDI doit passer par ici
+            struct GoldenEvent { int tick; std::vector<juce::uint8> bytes; };
+            const std::vector<GoldenEvent> golden = {
+                { 0,    { 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20 } },           // Tempo 120 BPM
+                { 0,    { 0xFF, 0x58, 0x04, 0x04, 0x02, 0x01, 0x60 } },     // Mesure 4/4
+                { 0,    { 0x90, 48, 100 } }, { 0,    { 0x90, 55, 100 } },
+                { 0,    { 0x90, 64, 100 } }, { 0,    { 0x90, 72, 100 } },
+                { 1920, { 0x80, 48, 0 } },   { 1920, { 0x80, 55, 0 } },
+                { 1920, { 0x80, 64, 0 } },   { 1920, { 0x80, 72, 0 } },
+                { 1920, { 0x90, 43, 100 } }, { 1920, { 0x90, 55, 100 } },
+                { 1920, { 0x90, 62, 100 } }, { 1920, { 0x90, 71, 100 } },
+                { 3840, { 0x80, 43, 0 } },   { 3840, { 0x80, 55, 0 } },
+                { 3840, { 0x80, 62, 0 } },   { 3840, { 0x80, 71, 0 } },
+            };
+            
+            juce::MidiFile midiFile;
+            juce::FileInputStream in(file);
+            expect(in.openedOk() && midiFile.readFrom(in, false), "Fichier relu");
+            expectEquals(midiFile.getNumTracks(), 1, "Une seule piste");
+            expectEquals(static_cast<int>(midiFile.getTimeFormat()), VoicingMidiWriter::ticksPerQuarterNote, "Résolution");
+            
+            std::vector<GoldenEvent> actual;
+            if (auto* track = midiFile.getTrack(0))
+            {
+                for (auto* holder : *track)
+                {
+                    const auto& message = holder->message;
+                    if (message.isEndOfTrackMetaEvent())
+                        continue;
+                    
+                    const auto* raw = message.getRawData();
+                    actual.push_back({ juce::roundToInt(message.getTimeStamp()),
+                                       std::vector<juce::uint8>(raw, raw + message.getRawDataSize()) });
+                }
+            }
+            
+            expectEquals(static_cast<int>(actual.size()), static_cast<int>(golden.size()), "Nombre d'événements");
+            for (size_t i = 0; i < std::min(actual.size(), golden.size()); ++i)
+                expect(actual[i].tick == golden[i].tick && actual[i].bytes == golden[i].bytes,
+                       "Événement " + juce::String(static_cast<int>(i)) + " conforme à la référence");
+            
+            file.deleteFile();
+            logMessage(juce::String::fromUTF8("✓ Sortie MIDI identique à la référence"));
+        }
+    }
+};
+
+static SolutionCacheTest solutionCacheTest;
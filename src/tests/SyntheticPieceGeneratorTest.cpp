@@ -0,0 +1,103 @@
+#include <JuceHeader.h>
+#include "model/Piece.h"
+#include "model/SyntheticPieceGenerator.h"
+#include "model/DiatonyTypes.h"
+#include <set>
+
+/** @brief Tests unitaires pour SyntheticPieceGenerator (pièces de charge reproductibles). */
+class SyntheticPieceGeneratorTest : public juce::UnitTest
+{
+public:
+    SyntheticPieceGeneratorTest() : juce::UnitTest("SyntheticPieceGenerator Tests", "generator_tests") {}
+
+    void runTest() override
+    {
+        beginTest(juce::String::fromUTF8("Taille exacte et structure valide"));
+        {
+            for (int size : { 10, 100, 1000 })
+            {
+                SyntheticPieceGenerator::Options options;
+                options.totalChords = size;
+
+                Piece piece;
+                SyntheticPieceGenerator::generate(piece, options);
+
+                expectEquals(piece.getTotalChordCount(), size, "Nombre d'accords demandé");
+                expect(piece.hasValidStructure(), "Alternance S-M-S respectée");
+                expectEquals(piece.getModulationCount() + 1, piece.getSectionCount(), "Une modulation entre chaque section");
+                expect(!piece.getUndoManager().canUndo(), "Pas d'historique d'undo");
+
+                for (const auto& section : piece.getSections())
+                {
+                    auto progression = section.getProgression();
+                    expect(progression.size() >= 2, "Au moins 2 accords par progression");
+                    expect(progression.getChord(progression.size() - 2).getDegree() == Diatony::ChordDegree::Fifth, "Cadence : V");
+                    expect(progression.getChord(progression.size() - 1).getDegree() == Diatony::ChordDegree::First, "Cadence : I");
+                }
+            }
+
+            logMessage(juce::String::fromUTF8("✓ 10, 100 et 1000 accords"));
+        }
+
+        beginTest(juce::String::fromUTF8("Reproductible par graine"));
+        {
+            SyntheticPieceGenerator::Options options;
+            options.totalChords = 200;
+            options.seed = 42;
+
+            Piece first, second, other;
+            SyntheticPieceGenerator::generate(first, options);
+            SyntheticPieceGenerator::generate(second, options);
+
+            options.seed = 43;
+            SyntheticPieceGenerator::generate(other, options);
+
+            expectEquals(first.getState().toXmlString(), second.getState().toXmlString(), "Même graine, même pièce");
+            expect(first.getState().toXmlString() != other.getState().toXmlString(), "Graine différente, pièce différente");
+
+            logMessage(juce::String::fromUTF8("✓ Génération déterministe"));
+        }
+
+        beginTest(juce::String::fromUTF8("Modes et types de modulation couverts"));
+        {
+            SyntheticPieceGenerator::Options options;
+            options.totalChords = 300;
+
+            Piece piece;
+            SyntheticPieceGenerator::generate(piece, options);
+
+            std::set<int> types;
+            for (const auto& modulation : piece.getModulations())
+                types.insert(static_cast<int>(modulation.getModulationType()));
+
+            bool hasMajor = false, hasMinor = false;
+            for (const auto& section : piece.getSections())
+                (section.getIsMajor() ? hasMajor : hasMinor) = true;
+
+            expectEquals(static_cast<int>(types.size()), 4, "Les 4 types de modulation");
+            expect(hasMajor && hasMinor, "Sections majeures et mineures");
+
+            logMessage(juce::String::fromUTF8("✓ Couverture des modes et modulations"));
+        }
+
+        beginTest(juce::String::fromUTF8("Export .diatony relu à l'identique"));
+        {
+            SyntheticPieceGenerator::Options options;
+            options.totalChords = 50;
+
+            Piece piece;
+            SyntheticPieceGenerator::generate(piece, options);
+
+            juce::TemporaryFile file(".diatony");
+            expect(SyntheticPieceGenerator::writeToFile(piece, file.getFile()), "Écriture");
+
+            auto xml = juce::XmlDocument::parse(file.getFile());
+            expect(xml != nullptr, "XML lisible");
+            expect(juce::ValueTree::fromXml(*xml).isEquivalentTo(piece.getState()), "Arbre identique");
+
+            logMessage(juce::String::fromUTF8("✓ Export .diatony"));
+        }
+    }
+};
+
+static SyntheticPieceGeneratorTest syntheticPieceGeneratorTest;
@@ -54,6 +54,8 @@ void MainContentComponent::setSelectionState(juce::ValueTree& state)
         
     selectionState = state;
     selectionState.addListener(this);
+    
+    historyPanel.setSelectionState(selectionState);
 }
 
 void MainContentComponent::paint(juce::Graphics& g)
@@ -124,17 +126,36 @@ void MainContentComponent::valueTreePropertyChanged(juce::ValueTree& treeWhosePr
                     DiatonyAlertWindow::AlertType::Info,
                     juce::String::fromUTF8("Generating..."),
                     juce::String::fromUTF8("Diatony is searching for a musical solution...\n\nPlease wait, this may take a few seconds."),
-                    ""  // Pas de bouton → non fermable par l'utilisateur
+                    "Cancel",
+                    [this]() { cancelGeneration(); }
                 );
             });
         }
+        else if (status == "cancelled")
+        {
+            juce::MessageManager::callAsync([this]() { closePopup(); });
+        }
         else if (status == "completed")
         {
-            juce::MessageManager::callAsync([this]() {
+            double totalTimeMs = treeWhosePropertyHasChanged.getProperty("generationTimeMs", 0.0);
+            juce::String source = treeWhosePropertyHasChanged.getProperty("generationSource", "solver").toString();
+            int pinnedChords = treeWhosePropertyHasChanged.getProperty("pinnedChords", 0);
+            
+            // Les résultats servis sans recherche complète sont signalés comme tels
+            juce::String origin;
+            if (source == "cache")
+                origin = "The solution was reused from the cache";
+            else if (source == "incremental")
+                origin = "Diatony re-solved the edited part (" + juce::String(pinnedChords) + " chords kept)";
+            else
+                origin = "A solution was found by the Diatony solver";
+            
+            juce::MessageManager::callAsync([this, origin, totalTimeMs]() {
                 showPopup(
                     DiatonyAlertWindow::AlertType::Success,
                     juce::String::fromUTF8("Generation Complete"),
-                    juce::String::fromUTF8("The MIDI file was generated successfully!\n\nA solution was found by the Diatony solver."),
+                    juce::String::fromUTF8("The MIDI file was generated successfully!\n\n")
+                        + origin + " in " + juce::String(totalTimeMs, 0) + " ms.",
                     "OK"
                 );
             });
@@ -180,13 +201,19 @@ void MainContentComponent::valueTreeParentChanged(juce::ValueTree&) {}
 void MainContentComponent::showPopup(DiatonyAlertWindow::AlertType type,
                                      const juce::String& title,
                                      const juce::String& message,
-                                     const juce::String& buttonText)
+                                     const juce::String& buttonText,
+                                     std::function<void()> onButtonClicked)
 {
     closePopup();
     
     auto alertWindow = std::make_unique<DiatonyAlertWindow>(
         type, title, message, buttonText,
-        [this]() { closePopup(); }
+        [this, onButtonClicked]()
+        {
+            closePopup();
+            if (onButtonClicked)
+                onButtonClicked();
+        }
     );
     
     // Créer l'overlay avec le popup
@@ -205,6 +232,12 @@ void MainContentComponent::closePopup()
     }
 }
 
+void MainContentComponent::cancelGeneration()
+{
+    if (auto* pluginEditor = findParentComponentOfClass<AudioPluginAudioProcessorEditor>())
+        pluginEditor->getAppController().cancelGeneration();
+}
+
 MainContentComponent::DragOverlay::DragOverlay()
 {
     setOpaque(false);
@@ -68,9 +68,13 @@ private:
     void showPopup(DiatonyAlertWindow::AlertType type,
                    const juce::String& title,
                    const juce::String& message,
-                   const juce::String& buttonText = "OK");
+                   const juce::String& buttonText = "OK",
+                   std::function<void()> onButtonClicked = nullptr);
     void closePopup();
     
+    /** @brief Bouton Cancel du popup "Generating..." : relaie l'annulation au contrôleur. */
+    void cancelGeneration();
+    
     class DragOverlay : public juce::Component
     {
     public:
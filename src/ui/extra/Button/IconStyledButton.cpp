@@ -7,11 +7,12 @@ IconStyledButton::IconStyledButton(const juce::String& buttonName,
                                    juce::Colour highlightColor,
                                    juce::Colour iconColor)
     : juce::Button(buttonName),
+      svgData(svgData),
+      svgDataSize(svgDataSize),
       backgroundNormal(normalColor),
       backgroundHighlight(highlightColor),
       iconColour(iconColor)
 {
-    originalIcon = loadSvgIcon(svgData, svgDataSize);
     updateIconColours();
 }
 
@@ -40,7 +41,7 @@ void IconStyledButton::paintButton(juce::Graphics& g, bool shouldDrawButtonAsHig
     g.setColour(backgroundColour);
     g.fillRoundedRectangle(bounds, 4.0f);
     
-    juce::Drawable* iconToDraw = normalIcon.get();
+    const juce::Drawable* iconToDraw = normalIcon.get();
     
     if (shouldDrawButtonAsDown && downIcon != nullptr)
         iconToDraw = downIcon.get();
@@ -54,28 +55,9 @@ void IconStyledButton::paintButton(juce::Graphics& g, bool shouldDrawButtonAsHig
     }
 }
 
-std::unique_ptr<juce::Drawable> IconStyledButton::loadSvgIcon(const char* data, size_t dataSize)
-{
-    auto svgString = juce::String::fromUTF8(data, static_cast<int>(dataSize));
-    auto svgXml = juce::XmlDocument::parse(svgString);
-    
-    if (svgXml == nullptr)
-        return nullptr;
-    
-    return juce::Drawable::createFromSVG(*svgXml);
-}
-
 void IconStyledButton::updateIconColours()
 {
-    if (originalIcon == nullptr)
-        return;
-    
-    normalIcon = originalIcon->createCopy();
-    normalIcon->replaceColour(juce::Colours::black, iconColour);
-    
-    hoverIcon = originalIcon->createCopy();
-    hoverIcon->replaceColour(juce::Colours::black, iconColour.brighter(0.2f));
-    
-    downIcon = originalIcon->createCopy();
-    downIcon->replaceColour(juce::Colours::black, iconColour.darker(0.2f));
+    normalIcon = iconCache->getTintedDrawable(svgData, svgDataSize, iconColour);
+    hoverIcon = iconCache->getTintedDrawable(svgData, svgDataSize, iconColour.brighter(0.2f));
+    downIcon = iconCache->getTintedDrawable(svgData, svgDataSize, iconColour.darker(0.2f));
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include <memory>
+#include "utils/IconCache.h"
 
 /** @brief Button avec icône SVG et couleurs de fond personnalisées. */
 class IconStyledButton : public juce::Button
@@ -22,13 +23,16 @@ protected:
     void paintButton(juce::Graphics& g, bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown) override;
 
 private:
-    std::unique_ptr<juce::Drawable> loadSvgIcon(const char* data, size_t dataSize);
     void updateIconColours();
     
-    std::unique_ptr<juce::Drawable> originalIcon;
-    std::unique_ptr<juce::Drawable> normalIcon;
-    std::unique_ptr<juce::Drawable> hoverIcon;
-    std::unique_ptr<juce::Drawable> downIcon;
+    juce::SharedResourcePointer<IconCache> iconCache;
+    const char* svgData;
+    size_t svgDataSize;
+    
+    // Variantes teintées partagées entre tous les boutons de même icône et couleur
+    IconCache::DrawablePtr normalIcon;
+    IconCache::DrawablePtr hoverIcon;
+    IconCache::DrawablePtr downIcon;
     
     juce::Colour backgroundNormal;
     juce::Colour backgroundHighlight;
@@ -17,11 +17,6 @@ InfoColoredPanel::InfoColoredPanel(juce::Colour color)
     
     degreeCombo.addListener(this);
     
-    lockIcon = juce::Drawable::createFromImageData(IconData::lock1svgrepocom_svg, 
-                                                    IconData::lock1svgrepocom_svgSize);
-    unlockIcon = juce::Drawable::createFromImageData(IconData::unlocksvgrepocom_svg, 
-                                                      IconData::unlocksvgrepocom_svgSize);
-    
     setupLabels();
 }
 
@@ -117,17 +112,17 @@ void InfoColoredPanel::drawTopSquares(juce::Graphics& g, const juce::Rectangle<i
 
 void InfoColoredPanel::drawLockIcon(juce::Graphics& g, const juce::Rectangle<int>& area, bool isLocked)
 {
-    auto* iconToDraw = isLocked ? lockIcon.get() : unlockIcon.get();
+    // Variante teintée partagée : ni analyse SVG ni copie à chaque paint
+    auto iconColor = getColor().contrasting(0.8f);
+    auto icon = isLocked
+        ? iconCache->getTintedDrawable(IconData::lock1svgrepocom_svg, IconData::lock1svgrepocom_svgSize, iconColor)
+        : iconCache->getTintedDrawable(IconData::unlocksvgrepocom_svg, IconData::unlocksvgrepocom_svgSize, iconColor);
     
-    if (iconToDraw == nullptr)
+    if (icon == nullptr)
         return;
     
-    auto iconCopy = iconToDraw->createCopy();
-    auto iconColor = getColor().contrasting(0.8f);
-    iconCopy->replaceColour(juce::Colours::black, iconColor);
-    
     auto iconBounds = area.toFloat().reduced(3.0f);
-    iconCopy->drawWithin(g, iconBounds, juce::RectanglePlacement::centred, 1.0f);
+    icon->drawWithin(g, iconBounds, juce::RectanglePlacement::centred, 1.0f);
 }
 
 void InfoColoredPanel::drawDeleteIcon(juce::Graphics& g, const juce::Rectangle<int>& area)
@@ -4,6 +4,7 @@
 #include "ColoredPanel.h"
 #include "ui/extra/Component/ComboBox/DiatonyComboBox.h"
 #include "utils/FontManager.h"
+#include "utils/IconCache.h"
 #include "IconBinaryData.h"
 
 namespace InfoPanelConfig
@@ -74,8 +75,7 @@ private:
     
     bool locked = false;
     juce::Rectangle<int> lockSquareArea;
-    std::unique_ptr<juce::Drawable> lockIcon;
-    std::unique_ptr<juce::Drawable> unlockIcon;
+    juce::SharedResourcePointer<IconCache> iconCache;  // Icônes cadenas analysées une fois pour tous les panels
     
     juce::Rectangle<int> deleteSquareArea;
     static constexpr int LONG_PRESS_DURATION_MS = 2500;
@@ -192,15 +192,7 @@ void HeaderPanel::updateDockState() {}
 
 void HeaderPanel::loadLogo()
 {
-    auto svgString = juce::String::fromUTF8(IconData::diatony_logo_svg, 
-                                            IconData::diatony_logo_svgSize);
-    auto svgXml = juce::XmlDocument::parse(svgString);
-    
-    if (svgXml == nullptr)
-        return;
-    
-    logoDrawable = juce::Drawable::createFromSVG(*svgXml);
-    
-    if (logoDrawable != nullptr)
-        logoDrawable->replaceColour(juce::Colours::black, juce::Colours::white);
+    juce::SharedResourcePointer<IconCache> iconCache;
+    logoDrawable = iconCache->getTintedDrawable(IconData::diatony_logo_svg, IconData::diatony_logo_svgSize,
+                                                juce::Colours::white);
 }
@@ -39,7 +39,7 @@ private:
     AppController* appController = nullptr;
     juce::SharedResourcePointer<FontManager> fontManager;
     
-    std::unique_ptr<juce::Drawable> logoDrawable;
+    IconCache::DrawablePtr logoDrawable;
     juce::Label mainLabel;
     StyledButton generateButton;
     MidiDragZone midiDragZone;
@@ -1,5 +1,7 @@
 #include "MidiDragZone.h"
 #include "utils/FontManager.h"
+#include "ui/PluginEditor.h"
+#include "controller/AppController.h"
 
 MidiDragZone::MidiDragZone()
 {
@@ -54,11 +56,65 @@ void MidiDragZone::paint(juce::Graphics& g)
     juce::SharedResourcePointer<FontManager> fontManager;
     auto fontOptions = fontManager->getSFProDisplay(11.0f, FontManager::FontWeight::Medium);
     g.setFont(juce::Font(fontOptions));
-    g.drawText("MIDI", bounds, juce::Justification::centred, false);
+    g.drawText(getLabelText(), bounds, juce::Justification::centred, false);
+}
+
+juce::String MidiDragZone::getLabelText() const
+{
+    if (solutionCount > 1 && solutionIndex > 0)
+        return "MIDI " + juce::String(solutionIndex) + "/" + juce::String(juce::jmax(solutionTotal, solutionCount));
+    
+    return "MIDI";
+}
+
+void MidiDragZone::showSolutionMenu()
+{
+    auto* pluginEditor = findParentComponentOfClass<AudioPluginAudioProcessorEditor>();
+    if (pluginEditor == nullptr)
+        return;
+    
+    juce::PopupMenu menu;
+    for (int i = 0; i < solutionCount; ++i)
+        menu.addItem(i + 1,
+                     "Solution " + juce::String(i + 1) + " of " + juce::String(juce::jmax(solutionTotal, solutionCount)),
+                     true, i + 1 == solutionIndex);
+    
+    // K : nombre de solutions à énumérer aux prochaines générations
+    const int currentCount = pluginEditor->getAppController().getEnumerationCount();
+    juce::PopupMenu countMenu;
+    for (int count : { 1, 2, 4, 8, GenerationService::maxEnumeratedSolutions })
+        countMenu.addItem(enumerationItemBase + count,
+                          count == 1 ? juce::String("1 (single solution)") : juce::String(count),
+                          true, count == currentCount);
+    
+    if (solutionCount > 1)
+        menu.addSeparator();
+    menu.addSubMenu("Solutions per generation", countMenu);
+    
+    juce::Component::SafePointer<AudioPluginAudioProcessorEditor> safeEditor(pluginEditor);
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this),
+                       [safeEditor](int result)
+                       {
+                           if (result <= 0 || safeEditor == nullptr)
+                               return;
+                           
+                           if (result > enumerationItemBase)
+                               safeEditor->getAppController().setEnumerationCount(result - enumerationItemBase);
+                           else
+                               safeEditor->getAppController().selectSolution(result - 1);
+                       });
 }
 
 void MidiDragZone::mouseDown(const juce::MouseEvent& event)
 {
+    // Clic droit : audition des solutions alternatives (reçues pendant que la recherche continue)
+    // et choix du nombre de solutions à énumérer
+    if (event.mods.isPopupMenu())
+    {
+        showSolutionMenu();
+        return;
+    }
+    
     if (!isMidiFileAvailable() || !midiFile.existsAsFile())
         return;
     
@@ -94,7 +150,10 @@ void MidiDragZone::valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHa
                                             const juce::Identifier& property)
 {
     if (property == juce::Identifier("generationStatus") || 
-        property == juce::Identifier("midiFilePath"))
+        property == juce::Identifier("midiFilePath") ||
+        property == juce::Identifier("solutionIndex") ||
+        property == juce::Identifier("solutionCount") ||
+        property == juce::Identifier("solutionTotal"))
     {
         juce::MessageManager::callAsync([this]() {
             updateFromSelectionState();
@@ -110,6 +169,10 @@ void MidiDragZone::updateFromSelectionState()
     juce::String status = selectionState.getProperty("generationStatus", "").toString();
     juce::String path = selectionState.getProperty("midiFilePath", "").toString();
     
+    solutionIndex = selectionState.getProperty("solutionIndex", 0);
+    solutionCount = selectionState.getProperty("solutionCount", 0);
+    solutionTotal = selectionState.getProperty("solutionTotal", 0);
+    
     if (status == "completed" && path.isNotEmpty())
     {
         midiFile = juce::File(path);
@@ -8,6 +8,8 @@ class AppController;
  * @brief Zone de drag & drop pour exporter le fichier MIDI vers un DAW.
  *
  * États visuels : inactif (grisé) ou prêt (coloré, fichier disponible).
+ * En mode énumération, affiche "MIDI i/K" ; clic droit pour choisir une autre solution
+ * ou le nombre K de solutions à énumérer.
  */
 class MidiDragZone : public juce::Component,
                      public juce::SettableTooltipClient,
@@ -35,15 +37,21 @@ public:
 private:
     void updateFromSelectionState();
     bool isMidiFileAvailable() const;
+    void showSolutionMenu();
+    juce::String getLabelText() const;
 
     juce::ValueTree selectionState;
     juce::File midiFile;
     bool isHovering = false;
+    int solutionIndex = 0;      // Solution affichée (1-based)
+    int solutionCount = 0;      // Solutions reçues jusqu'ici
+    int solutionTotal = 0;      // K attendu (ajusté à la fin de l'énumération)
 
     static constexpr juce::uint32 inactiveColour = 0xFF555555;  // Gris foncé
     static constexpr juce::uint32 readyColour = 0xFF4A90A4;     // Bleu tonique
     static constexpr juce::uint32 hoverColour = 0xFF5BA0B4;     // Bleu clair hover
     static constexpr float cornerRadius = 6.0f;
+    static constexpr int enumerationItemBase = 1000;                // Ids du sous-menu K (solutions : 1..K)
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiDragZone)
 };
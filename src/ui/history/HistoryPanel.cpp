@@ -94,6 +94,45 @@ void HistoryRowComponent::mouseDrag(const juce::MouseEvent& e)
     dragContainer->startDragging(dragDescription, this, juce::ScaledImage(dragImage), true);
 }
 
+/** @brief Scan du dossier des solutions hors du thread message ; les lots sont postés au panneau. */
+class HistoryPanel::ScanJob : public juce::ThreadPoolJob
+{
+public:
+    ScanJob(HistoryPanel& panel, int generation, juce::File directory, HistoryCatalogue::StampMap known)
+        : juce::ThreadPoolJob("History Scan"),
+          owner(&panel), scanGeneration(generation),
+          solutionsDirectory(std::move(directory)), knownStamps(std::move(known))
+    {
+    }
+    
+    JobStatus runJob() override
+    {
+        auto outcome = HistoryCatalogue::scan(solutionsDirectory, knownStamps,
+            [this] { return shouldExit(); },
+            [this](std::vector<HistoryItem> batch)
+            {
+                juce::MessageManager::callAsync([panel = owner, generation = scanGeneration,
+                                                 batch = std::move(batch)]() mutable {
+                    if (panel != nullptr)
+                        panel->applyScanBatch(generation, std::move(batch));
+                });
+            });
+        
+        juce::MessageManager::callAsync([panel = owner, generation = scanGeneration, outcome]() {
+            if (panel != nullptr)
+                panel->applyScanOutcome(generation, outcome);
+        });
+        
+        return jobHasFinished;
+    }
+    
+private:
+    juce::Component::SafePointer<HistoryPanel> owner;
+    const int scanGeneration;
+    const juce::File solutionsDirectory;
+    const HistoryCatalogue::StampMap knownStamps;
+};
+
 HistoryPanel::ContentContainer::ContentContainer()
 {
     setOpaque(false);
@@ -109,11 +148,14 @@ void HistoryPanel::ContentContainer::resized()
         openFolderButton->setBounds(buttonArea.reduced(12, 8));
     }
     
+    searchField.setBounds(bounds.removeFromTop(SEARCH_ZONE_HEIGHT).reduced(12, 4));
     historyList.setBounds(bounds);
 }
 
 HistoryPanel::HistoryPanel() 
-    : isPanelVisible(false),
+    : catalogue(FileUtils::getMidiSolutionsFolder(), FileUtils::getHistoryCatalogueFile()),
+      folderWatcher(catalogue.getDirectory(), "*.diatony"),
+      isPanelVisible(false),
       widthTransitionFraction(0.0f)
 {
     headerLabel.setText("History", juce::dontSendNotification);
@@ -132,6 +174,18 @@ HistoryPanel::HistoryPanel()
     contentContainer.openFolderButton->onClick = []() { FileUtils::openMidiSolutionsFolder(); };
     contentContainer.addAndMakeVisible(*contentContainer.openFolderButton);
     
+    auto& searchField = contentContainer.searchField;
+    searchField.setTextToShowWhenEmpty(juce::String::fromUTF8("Eb minor, V/V → V → I, s:2-4, pivot..."),
+                                       juce::Colour(0xFF777777));
+    searchField.setFont(juce::Font(fontManager->getSFProDisplay(13.0f, FontManager::FontWeight::Regular)));
+    searchField.setColour(juce::TextEditor::backgroundColourId, juce::Colour(0xFF2A2A2A));
+    searchField.setColour(juce::TextEditor::textColourId, juce::Colour(0xFFE0E0E0));
+    searchField.setColour(juce::TextEditor::outlineColourId, juce::Colour(0xFF444444));
+    searchField.setColour(juce::TextEditor::focusedOutlineColourId, juce::Colour(0xFF3A5A6A));
+    searchField.onTextChange = [this]() { setSearchText(contentContainer.searchField.getText()); };
+    searchField.onEscapeKey = [this]() { contentContainer.searchField.clear(); setSearchText({}); };
+    contentContainer.addAndMakeVisible(searchField);
+    
     contentContainer.historyList.setModel(this);
     contentContainer.historyList.setRowHeight(ROW_HEIGHT);
     contentContainer.historyList.setColour(juce::ListBox::backgroundColourId, juce::Colour(0xFF1A1A1A));
@@ -141,12 +195,24 @@ HistoryPanel::HistoryPanel()
     
     contentContainer.setAlpha(0.0f);
     addAndMakeVisible(contentContainer);
+    
+    // Autres instances du plugin, suppressions dans le Finder... : appliqués fichier par fichier
+    folderWatcher.onChange = [this](const juce::File& file, DirectoryWatcher::ChangeType change) {
+        handleFolderChange(file, change);
+    };
+    folderWatcher.onRescanNeeded = [this]() { refreshFromDisk(); };
 }
 
 HistoryPanel::~HistoryPanel()
 {
+    folderWatcher.stop();
+    scanPool.removeAllJobs(true, 2000);
+    
     if (appState.isValid())
         appState.removeListener(this);
+    
+    if (selectionState.isValid())
+        selectionState.removeListener(this);
 }
 
 void HistoryPanel::setAppState(juce::ValueTree& state)
@@ -159,6 +225,15 @@ void HistoryPanel::setAppState(juce::ValueTree& state)
     updateVisibilityState();
 }
 
+void HistoryPanel::setSelectionState(juce::ValueTree& state)
+{
+    if (selectionState.isValid())
+        selectionState.removeListener(this);
+    
+    selectionState = state;
+    selectionState.addListener(this);
+}
+
 void HistoryPanel::paint(juce::Graphics& g)
 {
     auto bounds = getLocalBounds();
@@ -189,86 +264,43 @@ float HistoryPanel::getWidthFraction() const { return widthTransitionFraction; }
 
 void HistoryPanel::refreshFromDisk()
 {
-    items.clear();
-    
-    juce::File solutionsDir = juce::File::getSpecialLocation(juce::File::userHomeDirectory)
-        .getChildFile(APPLICATION_SUPPORT_PATH)
-        .getChildFile("DiatonyDawApplication")
-        .getChildFile("Solutions")
-        .getChildFile("MidiFiles");
-    
-    if (!solutionsDir.exists())
-    {
-        contentContainer.historyList.updateContent();
-        return;
-    }
-    
-    juce::Array<juce::File> diatonyFiles;
-    solutionsDir.findChildFiles(diatonyFiles, juce::File::findFiles, false, "*.diatony");
-    
-    for (const auto& file : diatonyFiles)
-    {
-        HistoryItem item;
-        if (parseHistoryFile(file, item))
-            items.push_back(item);
-    }
+    // Un scan en cours est interrompu sans attente ; ses lots tardifs portent une génération périmée
+    scanPool.removeAllJobs(true, 0);
+    ++scanGeneration;
+    scanInProgress = true;
     
-    std::sort(items.begin(), items.end(), 
-        [](const HistoryItem& a, const HistoryItem& b) { return a.timestamp > b.timestamp; });
+    // L'index (déjà trié) s'affiche tout de suite, le scan ne fait que le compléter
+    auto known = catalogue.getStamps();
+    catalogueChanged();
     
-    contentContainer.historyList.updateContent();
+    scanPool.addJob(new ScanJob(*this, scanGeneration, catalogue.getDirectory(), std::move(known)), true);
 }
 
-bool HistoryPanel::parseHistoryFile(const juce::File& file, HistoryItem& outItem)
+void HistoryPanel::handleFolderChange(const juce::File& file, DirectoryWatcher::ChangeType change)
 {
-    auto xml = juce::XmlDocument::parse(file);
-    if (xml == nullptr || !xml->hasTagName("Piece"))
-        return false;
-    
-    outItem.diatonyFile = file;
-    outItem.midiFile = file.withFileExtension("mid");
-    outItem.name = file.getFileNameWithoutExtension();
-    outItem.timestamp = file.getLastModificationTime();
-    outItem.numSections = 0;
-    outItem.numModulations = 0;
-    outItem.numChords = 0;
-    outItem.startKey = "?";
-    
-    for (auto* child : xml->getChildIterator())
-    {
-        if (child->hasTagName("Section"))
-        {
-            outItem.numSections++;
-            
-            if (outItem.numSections == 1)
-            {
-                int noteIndex = child->getIntAttribute("tonalityNote", 0);
-                bool isMajor = child->getBoolAttribute("isMajor", true);
-                outItem.startKey = noteToKeyLabel(noteIndex, isMajor);
-            }
-            
-            if (auto* progression = child->getChildByName("Progression"))
-                outItem.numChords += progression->getNumChildElements();
-        }
-        else if (child->hasTagName("Modulation"))
-        {
-            outItem.numModulations++;
-        }
-    }
-    
-    return true;
+    const bool changed = change == DirectoryWatcher::ChangeType::removed ? catalogue.remove(file)
+                                                                         : catalogue.addOrUpdate(file);
+    if (changed)
+        catalogueChanged();
 }
 
-juce::String HistoryPanel::noteToKeyLabel(int noteIndex, bool isMajor)
+void HistoryPanel::applyScanBatch(int generation, std::vector<HistoryItem> batch)
 {
-    static const char* noteNames[] = { "C", "C#", "D", "Eb", "E", "F", "F#", "G", "Ab", "A", "Bb", "B" };
+    if (generation != scanGeneration)
+        return;
     
-    if (noteIndex < 0 || noteIndex > 11)
-        return "?";
+    if (catalogue.mergeBatch(std::move(batch)))
+        catalogueChanged();
+}
+
+void HistoryPanel::applyScanOutcome(int generation, const HistoryCatalogue::ScanOutcome& outcome)
+{
+    if (generation != scanGeneration)
+        return;
     
-    juce::String label = noteNames[noteIndex];
-    label += isMajor ? "" : "m";
-    return label;
+    scanInProgress = false;
+    if (catalogue.finishScan(outcome))
+        catalogueChanged();
 }
 
 juce::String HistoryPanel::formatTimestamp(const juce::Time& time)
@@ -285,9 +317,53 @@ juce::String HistoryPanel::formatTimestamp(const juce::Time& time)
         return time.formatted("%d/%m");
 }
 
+void HistoryPanel::setSearchText(const juce::String& text)
+{
+    activeQuery = HistoryQuery::parse(text);
+    applyFilter();
+}
+
+void HistoryPanel::catalogueChanged()
+{
+    searchIndexDirty = true;
+    applyFilter();
+}
+
+void HistoryPanel::applyFilter()
+{
+    filterActive = !activeQuery.isEmpty();
+    
+    if (filterActive)
+    {
+        if (searchIndexDirty)
+        {
+            searchIndex.rebuild(catalogue.getItems());
+            searchIndexDirty = false;
+        }
+        filteredRows = searchIndex.search(activeQuery);
+    }
+    else
+    {
+        filteredRows.clear();
+    }
+    
+    contentContainer.historyList.updateContent();
+    contentContainer.historyList.repaint();
+}
+
+const HistoryItem* HistoryPanel::getItemForRow(int row) const
+{
+    const auto& items = catalogue.getItems();
+    if (row < 0 || row >= getNumVisibleItems())
+        return nullptr;
+    
+    const auto index = filterActive ? filteredRows[static_cast<size_t>(row)] : row;
+    return &items[static_cast<size_t>(index)];
+}
+
 int HistoryPanel::getNumRows()
 {
-    return static_cast<int>(items.size());
+    return getNumVisibleItems();
 }
 
 void HistoryPanel::paintListBoxItem(int, juce::Graphics&, int, int, bool)
@@ -298,7 +374,8 @@ void HistoryPanel::paintListBoxItem(int, juce::Graphics&, int, int, bool)
 juce::Component* HistoryPanel::refreshComponentForRow(int rowNumber, bool isRowSelected,
                                                        juce::Component* existingComponentToUpdate)
 {
-    if (rowNumber < 0 || rowNumber >= static_cast<int>(items.size()))
+    const auto* item = getItemForRow(rowNumber);
+    if (item == nullptr)
     {
         if (existingComponentToUpdate != nullptr)
             delete existingComponentToUpdate;
@@ -309,22 +386,30 @@ juce::Component* HistoryPanel::refreshComponentForRow(int rowNumber, bool isRowS
     if (rowComponent == nullptr)
         rowComponent = new HistoryRowComponent(*this);
     
-    rowComponent->setRowData(items[static_cast<size_t>(rowNumber)], rowNumber, isRowSelected);
+    rowComponent->setRowData(*item, rowNumber, isRowSelected);
     return rowComponent;
 }
 
 void HistoryPanel::listBoxItemClicked(int, const juce::MouseEvent&) {}
 void HistoryPanel::listBoxItemDoubleClicked(int, const juce::MouseEvent&) {}
 
-void HistoryPanel::valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier& property)
+void HistoryPanel::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property)
 {
-    if (property == UIStateIdentifiers::historyPanelVisible)
+    if (tree == appState && property == UIStateIdentifiers::historyPanelVisible)
+    {
         updateVisibilityState();
-    else if (property.toString() == "generationStatus")
+    }
+    else if (tree == selectionState && property == juce::Identifier("midiFilePath"))
     {
-        juce::String status = appState.getProperty("generationStatus", "").toString();
-        if (status == "completed")
-            refreshFromDisk();
+        // Publié juste après "completed" : seul le .diatony écrit par cette génération est indexé
+        // (les solutions énumérées, sans .diatony, sont ignorées par le catalogue). La surveillance
+        // du dossier reverra ce fichier : inchangé, il n'est pas ré-analysé.
+        if (selectionState.getProperty("generationStatus", "").toString() != "completed")
+            return;
+        
+        juce::File midiFile(selectionState.getProperty("midiFilePath", "").toString());
+        if (midiFile != juce::File() && catalogue.addOrUpdate(midiFile.withFileExtension("diatony")))
+            catalogueChanged();
     }
 }
 
@@ -339,8 +424,12 @@ void HistoryPanel::updateVisibilityState()
     
     bool visible = static_cast<bool>(appState.getProperty(UIStateIdentifiers::historyPanelVisible, false));
     
-    if (visible)
+    // Premier affichage : surveillance démarrée avant le scan, pour ne rien manquer entre les deux
+    if (visible && !folderWatcher.isWatching())
+    {
+        folderWatcher.start();
         refreshFromDisk();
+    }
     
     if (onVisibilityChange)
         onVisibilityChange(visible);
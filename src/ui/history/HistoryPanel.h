@@ -3,22 +3,12 @@
 #include <JuceHeader.h>
 #include "utils/FontManager.h"
 #include "ui/extra/Button/StyledButton.h"
+#include "services/HistoryCatalogue.h"
+#include "services/DirectoryWatcher.h"
+#include "services/HistorySearchIndex.h"
 #include <vector>
 #include <memory>
 
-/** @brief Métadonnées d'une solution générée (pour drag & drop). */
-struct HistoryItem
-{
-    juce::File diatonyFile;    // Fichier .diatony source (XML avec ValueTree)
-    juce::File midiFile;       // Fichier .mid associé (même nom, extension différente)
-    juce::String name;
-    juce::Time timestamp;
-    juce::String startKey;
-    int numSections;
-    int numModulations;
-    int numChords;
-};
-
 class HistoryPanel;
 
 /** @brief Composant pour une ligne de l'historique avec drag & drop. */
@@ -56,18 +46,31 @@ public:
     ~HistoryPanel() override;
 
     void setAppState(juce::ValueTree& state);
+    
+    /** @brief État de sélection de l'AppController (generationStatus, midiFilePath). */
+    void setSelectionState(juce::ValueTree& state);
     void paint(juce::Graphics& g) override;
     void resized() override;
     
-    /** @brief Scanne le dossier des solutions et charge les fichiers .diatony. */
+    /**
+     * @brief Resynchronise le catalogue en arrière-plan : seuls les .diatony nouveaux ou modifiés
+     * sont analysés, et la liste se remplit par lots. Annule un scan encore en cours.
+     * Nécessaire seulement à la première ouverture (ou si la surveillance a perdu des événements) :
+     * ensuite, folderWatcher applique les changements du dossier un par un.
+     */
     void refreshFromDisk();
+    bool isScanning() const { return scanInProgress; }
     
     void setExpanded(bool expanded);
     bool getExpanded() const;
     juce::Component& getFadingComponent();
     float& getWidthFractionRef();
     float getWidthFraction() const;
-    const std::vector<HistoryItem>& getItems() const { return items; }
+    const std::vector<HistoryItem>& getItems() const { return catalogue.getItems(); }
+    
+    /** @brief Filtre la liste (syntaxe de HistoryQuery::parse) ; chaîne vide = tout afficher. */
+    void setSearchText(const juce::String& text);
+    int getNumVisibleItems() const { return filterActive ? static_cast<int>(filteredRows.size()) : static_cast<int>(getItems().size()); }
     
     /** @brief Formate le timestamp (heure si aujourd'hui, date sinon). */
     static juce::String formatTimestamp(const juce::Time& time);
@@ -92,9 +95,17 @@ public:
     void valueTreeParentChanged(juce::ValueTree&) override;
     
 private:
+    class ScanJob;
+    
     void updateVisibilityState();
-    bool parseHistoryFile(const juce::File& file, HistoryItem& outItem);
-    static juce::String noteToKeyLabel(int noteIndex, bool isMajor);
+    void applyScanBatch(int generation, std::vector<HistoryItem> batch);
+    void applyScanOutcome(int generation, const HistoryCatalogue::ScanOutcome& outcome);
+    void handleFolderChange(const juce::File& file, DirectoryWatcher::ChangeType change);
+    
+    /** @brief Le catalogue a changé : l'index de recherche est périmé, le filtre est réappliqué. */
+    void catalogueChanged();
+    void applyFilter();
+    const HistoryItem* getItemForRow(int row) const;
     
     juce::Label headerLabel;
     
@@ -105,17 +116,31 @@ private:
         void resized() override;
         
         std::unique_ptr<StyledButton> openFolderButton;
+        juce::TextEditor searchField;
         juce::ListBox historyList;
         static constexpr int BUTTON_ZONE_HEIGHT = 50;
+        static constexpr int SEARCH_ZONE_HEIGHT = 36;
     };
     
     ContentContainer contentContainer;
-    std::vector<HistoryItem> items;
+    HistoryCatalogue catalogue;
+    DirectoryWatcher folderWatcher;
+    
+    HistorySearchIndex searchIndex;     // Reconstruit à la demande, seulement quand un filtre est actif
+    bool searchIndexDirty = true;
+    HistoryQuery activeQuery;
+    std::vector<int> filteredRows;      // Rangs du catalogue affichés quand filterActive
+    bool filterActive = false;
     juce::SharedResourcePointer<FontManager> fontManager;
     
     bool isPanelVisible;
     float widthTransitionFraction;
     juce::ValueTree appState;
+    juce::ValueTree selectionState;
+    
+    juce::ThreadPool scanPool { 1 };
+    int scanGeneration = 0;         // Incrémenté à chaque refresh : les lots d'un scan périmé sont ignorés
+    bool scanInProgress = false;
     
     static constexpr int HEADER_HEIGHT = 60;
     static constexpr int PANEL_WIDTH = 250;
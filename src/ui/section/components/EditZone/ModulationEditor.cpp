@@ -17,6 +17,8 @@ ModulationEditor::ModulationEditor()
 
 ModulationEditor::~ModulationEditor()
 {
+    cancelPendingUpdate();
+    
     if (currentModulationState.isValid())
         currentModulationState.removeListener(this);
     
@@ -161,6 +163,12 @@ void ModulationEditor::unsubscribeFromSectionsAndProgressions()
         currentProgression2.removeListener(this);
         currentProgression2 = juce::ValueTree();
     }
+    
+    if (currentPieceState.isValid())
+    {
+        currentPieceState.removeListener(&chordCountListener);
+        currentPieceState = juce::ValueTree();
+    }
 }
 
 void ModulationEditor::subscribeToAdjacentSectionsAndProgressions()
@@ -195,6 +203,9 @@ void ModulationEditor::subscribeToAdjacentSectionsAndProgressions()
         if (currentProgression2.isValid())
             currentProgression2.addListener(this);
     }
+    
+    currentPieceState = piece.getState();
+    currentPieceState.addListener(&chordCountListener);
 }
 
 void ModulationEditor::setupModulationNameLabel()
@@ -339,8 +350,10 @@ void ModulationEditor::syncFromModel()
         int fromSectionIndex = piece.getSectionIndexById(fromSectionId);
         int toSectionIndex = piece.getSectionIndexById(toSectionId);
         
-        fromSectionZone.setSection(fromSection, fromSectionIndex);
-        toSectionZone.setSection(toSection, toSectionIndex);
+        fromSectionZone.setSection(fromSection, fromSectionIndex,
+                                   piece.getGlobalChordIndex(static_cast<size_t>(fromSectionIndex), 0));
+        toSectionZone.setSection(toSection, toSectionIndex,
+                                 piece.getGlobalChordIndex(static_cast<size_t>(toSectionIndex), 0));
         
         int fromChordIndex = modulation.getFromChordIndex();
         int toChordIndex = modulation.getToChordIndex();
@@ -440,32 +453,20 @@ void ModulationEditor::valueTreePropertyChanged(juce::ValueTree& treeWhoseProper
     juce::ignoreUnused(property);
 }
 
-void ModulationEditor::valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenAdded)
+void ModulationEditor::handleAsyncUpdate()
 {
-    // Si un accord a été ajouté dans une des progressions, resynchroniser la vue
-    if (childWhichHasBeenAdded.hasType(ModelIdentifiers::CHORD))
-    {
-        if ((currentProgression1.isValid() && parentTree == currentProgression1) ||
-            (currentProgression2.isValid() && parentTree == currentProgression2))
-        {
-            syncFromModel();
-        }
-    }
+    syncFromModel();
 }
 
-void ModulationEditor::valueTreeChildRemoved(juce::ValueTree& parentTree, 
-                                            juce::ValueTree& childWhichHasBeenRemoved, 
-                                            int)
+void ModulationEditor::ChordCountListener::valueTreeChildAdded(juce::ValueTree&, juce::ValueTree& child)
 {
-    // Si un accord a été supprimé dans une des progressions, resynchroniser la vue
-    juce::ignoreUnused(index);
-    
-    if (childWhichHasBeenRemoved.hasType(ModelIdentifiers::CHORD))
-    {
-        if ((currentProgression1.isValid() && parentTree == currentProgression1) ||
-            (currentProgression2.isValid() && parentTree == currentProgression2))
-        {
-            syncFromModel();
-        }
-    }
+    // Différé : PieceIndex (listener de la racine) n'a peut-être pas encore mis à jour les décalages
+    if (child.hasType(ModelIdentifiers::SECTION) || child.hasType(ModelIdentifiers::CHORD))
+        owner.triggerAsyncUpdate();
+}
+
+void ModulationEditor::ChordCountListener::valueTreeChildRemoved(juce::ValueTree&, juce::ValueTree& child, int)
+{
+    if (child.hasType(ModelIdentifiers::SECTION) || child.hasType(ModelIdentifiers::CHORD))
+        owner.triggerAsyncUpdate();
 }
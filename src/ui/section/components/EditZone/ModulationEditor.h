@@ -15,7 +15,7 @@
 class AudioPluginAudioProcessorEditor;
 
 /** @brief Éditeur de modulation avec sélection du type et visualisation des accords adjacents. */
-class ModulationEditor : public juce::Component, public juce::ValueTree::Listener
+class ModulationEditor : public juce::Component, public juce::ValueTree::Listener, private juce::AsyncUpdater
 {
 public:
     ModulationEditor();
@@ -46,6 +46,23 @@ private:
     juce::ValueTree currentProgression1;  // Progression de la section source
     juce::ValueTree currentProgression2;  // Progression de la section destination
     
+    /**
+     * @brief Accords/sections ajoutés ou supprimés n'importe où dans la pièce : contenu et numéros de mesure
+     * à resynchroniser, de façon asynchrone (après la mise à jour de PieceIndex).
+     */
+    struct ChordCountListener : public juce::ValueTree::Listener
+    {
+        explicit ChordCountListener(ModulationEditor& editor) : owner(editor) {}
+        
+        void valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& child) override;
+        void valueTreeChildRemoved(juce::ValueTree& parentTree, juce::ValueTree& child, int) override;
+        
+        ModulationEditor& owner;
+    };
+    
+    juce::ValueTree currentPieceState;
+    ChordCountListener chordCountListener { *this };
+    
     AppController* appController = nullptr;
     
     juce::Label modulationNameLabel;
@@ -84,10 +101,12 @@ private:
     // ValueTree::Listener
     void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged,
                                   const juce::Identifier& property) override;
-    void valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenAdded) override;
-    void valueTreeChildRemoved(juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenRemoved, int index) override;
+    void valueTreeChildAdded(juce::ValueTree&, juce::ValueTree&) override {}      // Via ChordCountListener
+    void valueTreeChildRemoved(juce::ValueTree&, juce::ValueTree&, int) override {}
     void valueTreeChildOrderChanged(juce::ValueTree&, int, int) override {}
     void valueTreeParentChanged(juce::ValueTree&) override {}
     
+    void handleAsyncUpdate() override;
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulationEditor)
 };
@@ -44,6 +44,13 @@ void ChordChip::paint(juce::Graphics& g)
     auto font = juce::Font(fontManager->getSFProDisplay(11.0f, FontManager::FontWeight::Bold));
     g.setFont(font);
     g.drawText(getDisplayText(), bounds, juce::Justification::centred, false);
+    
+    if (barNumber > 0)
+    {
+        g.setFont(juce::Font(fontManager->getSFProDisplay(8.0f)));
+        g.setColour(juce::Colours::white.withAlpha(isEnabled() ? 0.7f : 0.35f));
+        g.drawText(juce::String(barNumber), bounds.reduced(3.0f, 1.0f), juce::Justification::topLeft, false);
+    }
 }
 
 void ChordChip::setSelected(bool newSelected)
@@ -63,6 +70,15 @@ void ChordChip::setChordData(int newIndex, Diatony::ChordDegree newDegree, Diato
     repaint();
 }
 
+void ChordChip::setBarNumber(int newBarNumber)
+{
+    if (barNumber != newBarNumber)
+    {
+        barNumber = newBarNumber;
+        repaint();
+    }
+}
+
 juce::String ChordChip::getDisplayText() const
 {
     juce::String text = DiatonyText::getChordDegreeName(degree);
@@ -30,12 +30,17 @@ public:
     Diatony::ChordQuality getQuality() const { return quality; }
     
     void setChordData(int newIndex, Diatony::ChordDegree newDegree, Diatony::ChordQuality newQuality);
+    
+    /** @brief Numéro de mesure affiché en petit dans le coin du chip (0 : masqué). */
+    void setBarNumber(int newBarNumber);
+    int getBarNumber() const { return barNumber; }
 
 private:
     int chordIndex;
     Diatony::ChordDegree degree;
     Diatony::ChordQuality quality;
     bool selected = false;
+    int barNumber = 0;
     
     juce::SharedResourcePointer<FontManager> fontManager;
     
@@ -12,7 +12,7 @@ void SectionChordsZone::enablementChanged()
         chip->setEnabled(isEnabled());
 }
 
-void SectionChordsZone::setSection(const Section& section, int sectionIndex)
+void SectionChordsZone::setSection(const Section& section, int sectionIndex, int firstGlobalChordIndex)
 {
     if (!section.isValid())
     {
@@ -67,6 +67,9 @@ void SectionChordsZone::setSection(const Section& section, int sectionIndex)
             chord.getQuality()
         );
         
+        if (firstGlobalChordIndex >= 0)
+            chip->setBarNumber(firstGlobalChordIndex + static_cast<int>(i) + 1);
+        
         chip->onClick = [this](int chordIndex) {
             setSelectedChordIndex(chordIndex);
             if (onChordSelected)
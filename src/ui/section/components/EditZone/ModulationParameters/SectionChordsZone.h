@@ -23,7 +23,8 @@ public:
     SectionChordsZone(DisplayMode mode);
     ~SectionChordsZone() override = default;
     
-    void setSection(const Section& section, int sectionIndex);
+    /** @brief firstGlobalChordIndex >= 0 : chaque chip indique sa mesure dans le MIDI généré (un accord par mesure). */
+    void setSection(const Section& section, int sectionIndex, int firstGlobalChordIndex = -1);
     
     std::function<void(int chordIndex)> onChordSelected;
     
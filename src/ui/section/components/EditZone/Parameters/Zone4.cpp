@@ -49,10 +49,7 @@ void Zone4::resizeContent(const juce::Rectangle<int>& contentBounds)
 
 void Zone4::syncWithProgression(const std::vector<juce::ValueTree>& chords)
 {
-    contentAreaComponent.clearAllRectangles();
-    
-    // Ajouter autant de rectangles qu'il y a d'accords avec leurs valeurs connectées au ValueTree
-    for (const auto& chordState : chords)
-        contentAreaComponent.addRectangle(chordState);
+    // Réconciliation par ID : seuls les panneaux des accords modifiés sont recréés
+    contentAreaComponent.syncWithChords(chords);
 }
 
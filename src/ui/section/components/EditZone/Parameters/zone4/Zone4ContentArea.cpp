@@ -35,6 +35,7 @@ void Zone4ContentArea::resized()
     {
         int availableHeight = contentArea.getHeight();
         scrollableContent->setSize(scrollableContent->getWidth(), availableHeight);
+        scrollableContent->updateContentSize();  // La largeur du Viewport a pu changer : plage visible
     }
 }
 
@@ -44,88 +45,134 @@ void Zone4ContentArea::addRectangle()
 }
 
 void Zone4ContentArea::addRectangle(juce::ValueTree chordState)
+{
+    auto chords = chordTrees;
+    chords.push_back(chordState);
+    syncWithChords(chords);
+}
+
+void Zone4ContentArea::syncWithChords(const std::vector<juce::ValueTree>& chords)
 {
     if (!scrollableContent)
         return;
     
+    const int previousCount = static_cast<int>(chordTrees.size());
+    const int previousLastId = previousCount > 0 ? static_cast<int>(chordTrees.back().getProperty(ModelIdentifiers::id, -1)) : -1;
+    
+    chordTrees = chords;
+    
+    // Clés = IDs d'accords : un panneau visible dont l'accord subsiste est conservé tel quel
+    std::vector<int> chordIds;
+    chordIds.reserve(chords.size());
+    for (const auto& chordState : chords)
+        chordIds.push_back(chordState.getProperty(ModelIdentifiers::id, -1));
+    
+    scrollableContent->setItems(std::move(chordIds));
+    
+    updateVisibility();
+    resized();
+    
+    // Accord ajouté en fin : suivre l'ajout, sinon la position de défilement est conservée
+    const int lastId = chordTrees.empty() ? -1 : static_cast<int>(chordTrees.back().getProperty(ModelIdentifiers::id, -1));
+    if (static_cast<int>(chordTrees.size()) > previousCount && lastId != previousLastId)
+        scrollToEnd();
+}
+
+std::unique_ptr<juce::Component> Zone4ContentArea::createPanel()
+{
     auto newRectangle = std::make_unique<InfoColoredPanel>(getNextColour());
     newRectangle->setAlpha(0.8f);
-    newRectangle->setNumber(nextRectangleId - 1);
     
     populateInfoColoredPanel(newRectangle.get());
     
-    if (chordState.isValid())
+    return newRectangle;
+}
+
+void Zone4ContentArea::bindPanel(juce::Component& component, int chordIndex)
+{
+    auto* panel = dynamic_cast<InfoColoredPanel*>(&component);
+    if (panel == nullptr || chordIndex < 0 || chordIndex >= static_cast<int>(chordTrees.size()))
+        return;
+    
+    panel->setNumber(chordIndex + 1);
+    bindPanel(panel, chordTrees[static_cast<size_t>(chordIndex)]);
+}
+
+void Zone4ContentArea::bindPanel(InfoColoredPanel* panel, juce::ValueTree chordState)
+{
+    auto& degreeCombo = panel->getDegreeCombo();
+    auto& stateCombo = panel->getStateCombo();
+    auto& qualityCombo = panel->getQualityCombo();
+    
+    // Conversion quality : enumValue + 1 (car Auto=-1 est à l'index 0)
+    const int degree = chordState.isValid() ? static_cast<int>(chordState.getProperty(ModelIdentifiers::degree, 0)) : 0;
+    const int state = chordState.isValid() ? static_cast<int>(chordState.getProperty(ModelIdentifiers::state, 0)) : 0;
+    const int qualityIndex = chordState.isValid() ? static_cast<int>(chordState.getProperty(ModelIdentifiers::quality, -1)) + 1 : 0;
+    
+    // Seuls les combos dont la valeur a changé sont rafraîchis
+    auto select = [](DiatonyComboBox& combo, int index)
     {
-        int degree = chordState.getProperty(ModelIdentifiers::degree, 0);
-        int quality = chordState.getProperty(ModelIdentifiers::quality, -1);
-        int state = chordState.getProperty(ModelIdentifiers::state, 0);
-        
-        // Conversion quality : enumValue + 1 (car Auto=-1 est à l'index 0)
-        newRectangle->getDegreeCombo().setSelectedItemIndex(degree, juce::dontSendNotification);
-        newRectangle->getStateCombo().setSelectedItemIndex(state, juce::dontSendNotification);
-        newRectangle->getQualityCombo().setSelectedItemIndex(quality + 1, juce::dontSendNotification);
-        
-        newRectangle->getDegreeCombo().refreshDisplayedText();
-        newRectangle->getStateCombo().refreshDisplayedText();
-        newRectangle->getQualityCombo().refreshDisplayedText();
-        
-        auto* degreeCombo = &newRectangle->getDegreeCombo();
-        auto* stateCombo = &newRectangle->getStateCombo();
-        auto* qualityCombo = &newRectangle->getQualityCombo();
-        
-        degreeCombo->onChange = [chordState, degreeCombo]() mutable {
-            int newDegree = degreeCombo->getSelectedItemIndex();
-            chordState.setProperty(ModelIdentifiers::degree, newDegree, nullptr);
-        };
-        
-        stateCombo->onChange = [chordState, stateCombo]() mutable {
-            int newState = stateCombo->getSelectedItemIndex();
-            chordState.setProperty(ModelIdentifiers::state, newState, nullptr);
-        };
-        
-        qualityCombo->onChange = [chordState, qualityCombo]() mutable {
-            int comboboxIndex = qualityCombo->getSelectedItemIndex();
-            int newQuality = comboboxIndex - 1;  // Conversion inverse
-            chordState.setProperty(ModelIdentifiers::quality, newQuality, nullptr);
-        };
-        
-        // On capture chordState pour trouver dynamiquement son index au moment de la suppression
-        newRectangle->onDeleteRequested = [this, chordState]() mutable {
-            if (onChordRemoved && chordState.isValid())
-            {
-                auto parent = chordState.getParent();
-                if (parent.isValid())
-                {
-                    int chordIndex = parent.indexOf(chordState);
-                    if (chordIndex >= 0)
-                        onChordRemoved(chordIndex);
-                }
-            }
-        };
-    }
-    else
+        if (combo.getSelectedItemIndex() == index)
+            return;
+        combo.setSelectedItemIndex(index, juce::dontSendNotification);
+        combo.refreshDisplayedText();
+    };
+    select(degreeCombo, degree);
+    select(stateCombo, state);
+    select(qualityCombo, qualityIndex);
+    
+    if (!chordState.isValid())
     {
-        newRectangle->getDegreeCombo().setSelectedItemIndex(0, juce::dontSendNotification);
-        newRectangle->getStateCombo().setSelectedItemIndex(0, juce::dontSendNotification);
-        newRectangle->getQualityCombo().setSelectedItemIndex(0, juce::dontSendNotification);
-        
-        newRectangle->getDegreeCombo().refreshDisplayedText();
-        newRectangle->getStateCombo().refreshDisplayedText();
-        newRectangle->getQualityCombo().refreshDisplayedText();
+        // Panneau recyclé : ne pas rester branché sur l'accord précédent
+        degreeCombo.onChange = nullptr;
+        stateCombo.onChange = nullptr;
+        qualityCombo.onChange = nullptr;
+        panel->onDeleteRequested = nullptr;
+        return;
     }
     
-    std::unique_ptr<juce::Component> component(newRectangle.release());
-    scrollableContent->addRectangle(std::move(component));
+    auto* degreeComboPtr = &degreeCombo;
+    auto* stateComboPtr = &stateCombo;
+    auto* qualityComboPtr = &qualityCombo;
     
-    updateVisibility();
-    resized();
+    degreeCombo.onChange = [chordState, degreeComboPtr]() mutable {
+        int newDegree = degreeComboPtr->getSelectedItemIndex();
+        chordState.setProperty(ModelIdentifiers::degree, newDegree, nullptr);
+    };
     
+    stateCombo.onChange = [chordState, stateComboPtr]() mutable {
+        int newState = stateComboPtr->getSelectedItemIndex();
+        chordState.setProperty(ModelIdentifiers::state, newState, nullptr);
+    };
+    
+    qualityCombo.onChange = [chordState, qualityComboPtr]() mutable {
+        int comboboxIndex = qualityComboPtr->getSelectedItemIndex();
+        int newQuality = comboboxIndex - 1;  // Conversion inverse
+        chordState.setProperty(ModelIdentifiers::quality, newQuality, nullptr);
+    };
+    
+    // On capture chordState pour trouver dynamiquement son index au moment de la suppression
+    panel->onDeleteRequested = [this, chordState]() mutable {
+        if (onChordRemoved && chordState.isValid())
+        {
+            auto parent = chordState.getParent();
+            if (parent.isValid())
+            {
+                int chordIndex = parent.indexOf(chordState);
+                if (chordIndex >= 0)
+                    onChordRemoved(chordIndex);
+            }
+        }
+    };
+}
+
+void Zone4ContentArea::scrollToEnd()
+{
     // Auto-scroll vers le dernier élément ajouté
     juce::MessageManager::callAsync([this]() {
         if (scrollableContent)
         {
-            int numRectangles = scrollableContent->getNumRectangles();
-            if (numRectangles > 0)
+            if (scrollableContent->getNumItems() > 0)
             {
                 int contentWidth = scrollableContent->getWidth();
                 int viewWidth = viewport.getViewWidth();
@@ -140,7 +187,8 @@ void Zone4ContentArea::clearAllRectangles()
 {
     if (scrollableContent)
     {
-        scrollableContent->clearAllRectangles();
+        chordTrees.clear();
+        scrollableContent->clearAllItems();
         nextRectangleId = 1; // Reset du compteur
         updateVisibility();
         resized();
@@ -149,7 +197,7 @@ void Zone4ContentArea::clearAllRectangles()
 
 bool Zone4ContentArea::hasContent() const
 {
-    return scrollableContent && scrollableContent->getNumRectangles() > 0;
+    return scrollableContent && scrollableContent->getNumItems() > 0;
 }
 
 juce::Rectangle<int> Zone4ContentArea::getPreferredSize() const
@@ -162,6 +210,10 @@ void Zone4ContentArea::setupViewport()
     int initialHeight = PREFERRED_HEIGHT - TOP_PADDING - BOTTOM_PADDING;
     scrollableContent->setSize(100, initialHeight);
     
+    // Seuls les panneaux visibles existent : fabriqués une fois, puis recyclés au défilement
+    scrollableContent->createItem = [this]() { return createPanel(); };
+    scrollableContent->bindItem = [this](juce::Component& component, int chordIndex) { bindPanel(component, chordIndex); };
+    
     viewport.setViewedComponent(scrollableContent.get(), false);
     viewport.setScrollBarsShown(false, true, false, false);
     viewport.setScrollBarPosition(true, true);
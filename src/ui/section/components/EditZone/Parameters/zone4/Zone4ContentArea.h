@@ -24,6 +24,12 @@ public:
     void clearAllRectangles();
     bool hasContent() const;
     
+    /**
+     * @brief Réconciliation par ID d'accord sur une bande virtualisée : seuls les panneaux visibles
+     * existent ; ceux dont l'accord reste visible sont conservés, les autres recyclés.
+     */
+    void syncWithChords(const std::vector<juce::ValueTree>& chords);
+    
     /** @brief Callback appelé quand un accord doit être supprimé (index de l'accord). */
     std::function<void(int)> onChordRemoved;
     
@@ -43,6 +49,9 @@ private:
     // Compteur pour les rectangles
     int nextRectangleId = 1;
     
+    // Accords de la progression affichée ; les panneaux n'existent que pour la plage visible
+    std::vector<juce::ValueTree> chordTrees;
+    
     // Les 16 degrés d'accords disponibles
     static constexpr std::array<Diatony::ChordDegree, 16> chordDegrees = {
         Diatony::ChordDegree::First, Diatony::ChordDegree::Second,
@@ -78,6 +87,10 @@ private:
     void updateVisibility();
     juce::Colour getNextColour();
     void populateInfoColoredPanel(InfoColoredPanel* panel);
+    std::unique_ptr<juce::Component> createPanel();
+    void bindPanel(juce::Component& component, int chordIndex);
+    void bindPanel(InfoColoredPanel* panel, juce::ValueTree chordState);
+    void scrollToEnd();
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Zone4ContentArea)
 };
@@ -1,5 +1,5 @@
 #include "Zone4ScrollablePanel.h"
-#include "ui/extra/Component/Panel/InfoColoredPanel.h"
+#include <unordered_map>
 
 Zone4ScrollablePanel::Zone4ScrollablePanel() {}
 
@@ -9,91 +9,158 @@ void Zone4ScrollablePanel::resized()
 {
     // Recalculer la taille totale nécessaire car la hauteur peut avoir changé
     // (et la hauteur affecte la largeur des rectangles)
-    if (!rectangles.empty())
-        updateContentSize();
-    else
-        layoutRectangles();
+    updateContentSize();
 }
 
-void Zone4ScrollablePanel::addRectangle(std::unique_ptr<juce::Component> component)
+void Zone4ScrollablePanel::moved()
 {
-    // Les dimensions sont ignorées car layoutRectangles() recalcule selon la hauteur disponible
-    addRectangle(std::move(component), 0, 0);
+    // Défilement du Viewport : ne matérialiser que si la plage visible a changé
+    if (getVisibleIndexRange() != materialisedRange)
+        updateVisibleItems(false);
 }
 
-void Zone4ScrollablePanel::addRectangle(std::unique_ptr<juce::Component> component, int width, int height)
+void Zone4ScrollablePanel::setItems(std::vector<int> newItemKeys)
 {
-    if (!component)
-        return;
-        
-    addAndMakeVisible(*component);
-    rectangles.emplace_back(std::move(component), width, height);
-    updateContentSize();
-}
+    itemKeys = std::move(newItemKeys);
 
-void Zone4ScrollablePanel::clearAllRectangles()
-{
-    rectangles.clear();
-    updateContentSize();
+    const int totalWidth = calculateRequiredWidth();
+    if (totalWidth != getWidth())
+        setSize(totalWidth, getHeight() > 0 ? getHeight() : 35);
+
+    updateVisibleItems(true);
 }
 
-int Zone4ScrollablePanel::getNumRectangles() const
+void Zone4ScrollablePanel::clearAllItems()
 {
-    return static_cast<int>(rectangles.size());
+    setItems({});
 }
 
 void Zone4ScrollablePanel::updateContentSize()
 {
     auto currentHeight = getHeight();
-    if (currentHeight <= 0) 
+    if (currentHeight <= 0)
         currentHeight = 35;
-    
+
     const int totalWidth = calculateRequiredWidth();
     setSize(totalWidth, currentHeight);
-    layoutRectangles();
+    updateVisibleItems(false);
 }
 
-void Zone4ScrollablePanel::layoutRectangles()
+juce::Range<int> Zone4ScrollablePanel::getVisibleIndexRange() const
 {
-    if (rectangles.empty())
-        return;
-        
-    int x = 0;
-    int totalHeight = getHeight();
-    int rectangleHeight = totalHeight - SCROLLBAR_SPACE;
-    int rectangleWidth = calculateChordWidth(rectangleHeight);
-    
-    for (auto& rectInfo : rectangles)
+    if (itemKeys.empty())
+        return {};
+
+    const int stride = calculateChordWidth(getRectangleHeight()) + ChordPanelConfig::CHORD_SPACING;
+    const int viewLeft = juce::jmax(0, -getX());
+    const int viewWidth = getParentComponent() != nullptr ? getParentWidth() : getWidth();
+
+    const int first = juce::jmax(0, viewLeft / stride - ChordPanelConfig::OVERSCAN);
+    const int last = juce::jmin(getNumItems(), (viewLeft + viewWidth) / stride + 1 + ChordPanelConfig::OVERSCAN);
+    return { first, juce::jmax(first, last) };
+}
+
+void Zone4ScrollablePanel::updateVisibleItems(bool rebindAll)
+{
+    const auto range = getVisibleIndexRange();
+    materialisedRange = range;
+
+    // Clé → indice, restreint à la plage à matérialiser
+    std::unordered_map<int, int> wantedIndexByKey;
+    for (int i = range.getStart(); i < range.getEnd(); ++i)
+        wantedIndexByKey[itemKeys[static_cast<size_t>(i)]] = i;
+
+    std::vector<bool> covered(static_cast<size_t>(range.getLength()), false);
+    std::vector<VisibleItem> kept;
+    kept.reserve(static_cast<size_t>(range.getLength()));
+
+    // 1. Les composants dont l'élément reste visible sont conservés, les autres vont au pool
+    for (auto& item : visibleItems)
     {
-        rectInfo.component->setBounds(x, 0, rectangleWidth, rectangleHeight);
-        x += rectangleWidth + ChordPanelConfig::CHORD_SPACING;
+        auto wanted = wantedIndexByKey.find(item.key);
+        const size_t slot = wanted != wantedIndexByKey.end() ? static_cast<size_t>(wanted->second - range.getStart()) : 0;
+
+        if (wanted != wantedIndexByKey.end() && !covered[slot])
+        {
+            covered[slot] = true;
+            const bool indexChanged = item.index != wanted->second;
+            item.index = wanted->second;
+
+            if ((rebindAll || indexChanged) && bindItem)
+                bindItem(*item.component, item.index);
+
+            kept.push_back(std::move(item));
+        }
+        else
+        {
+            item.component->setVisible(false);
+            pool.push_back(std::move(item.component));
+        }
+    }
+
+    // 2. Les trous de la plage sont comblés par recyclage, création en dernier recours
+    for (int i = range.getStart(); i < range.getEnd(); ++i)
+    {
+        if (covered[static_cast<size_t>(i - range.getStart())])
+            continue;
+
+        std::unique_ptr<juce::Component> component;
+        if (!pool.empty())
+        {
+            component = std::move(pool.back());
+            pool.pop_back();
+        }
+        else if (createItem)
+        {
+            component = createItem();
+            if (component == nullptr)
+                continue;
+            addChildComponent(*component);
+        }
+        else
+        {
+            continue;
+        }
+
+        if (bindItem)
+            bindItem(*component, i);
+        component->setVisible(true);
+        kept.push_back({ itemKeys[static_cast<size_t>(i)], i, std::move(component) });
     }
+
+    visibleItems = std::move(kept);
+
+    // 3. Placement : position absolue de chaque élément dans la bande complète
+    const int rectangleHeight = getRectangleHeight();
+    const int rectangleWidth = calculateChordWidth(rectangleHeight);
+    const int stride = rectangleWidth + ChordPanelConfig::CHORD_SPACING;
+
+    for (auto& item : visibleItems)
+        item.component->setBounds(item.index * stride, 0, rectangleWidth, rectangleHeight);
 }
 
 int Zone4ScrollablePanel::calculateChordWidth(int height) const
 {
     int width;
-    
+
     if (ChordPanelConfig::CHORD_WIDTH_FIXED > 0)
         width = ChordPanelConfig::CHORD_WIDTH_FIXED;
     else
         width = static_cast<int>(height * ChordPanelConfig::CHORD_WIDTH_RATIO);
-    
+
     return juce::jmax(width, ChordPanelConfig::CHORD_WIDTH_MIN);
 }
 
 int Zone4ScrollablePanel::calculateRequiredWidth() const
 {
-    if (rectangles.empty())
+    if (itemKeys.empty())
         return MIN_CONTENT_WIDTH;
-    
-    int totalHeight = getHeight();
-    int rectangleHeight = totalHeight - SCROLLBAR_SPACE;
-    int rectangleWidth = calculateChordWidth(rectangleHeight);
-    
-    int totalWidth = static_cast<int>(rectangles.size()) * rectangleWidth 
-                   + static_cast<int>(rectangles.size() - 1) * ChordPanelConfig::CHORD_SPACING
+
+    int rectangleWidth = calculateChordWidth(getRectangleHeight());
+
+    int totalWidth = getNumItems() * rectangleWidth
+                   + (getNumItems() - 1) * ChordPanelConfig::CHORD_SPACING
                    + ChordPanelConfig::CHORD_SPACING * 2;
-    
+
     return juce::jmax(totalWidth, MIN_CONTENT_WIDTH);
 }
@@ -9,44 +9,61 @@ namespace ChordPanelConfig
     constexpr float CHORD_WIDTH_RATIO = 0.5f; // Ratio hauteur→largeur (si FIXED == 0)
     constexpr int CHORD_WIDTH_MIN = 50;       // Largeur minimale
     constexpr int CHORD_SPACING = 8;          // Espace entre les accords
+    constexpr int OVERSCAN = 3;               // Panneaux matérialisés de part et d'autre de la zone visible
 }
 
-/** @brief Informations d'un rectangle avec ses dimensions. */
-struct RectangleInfo
-{
-    std::unique_ptr<juce::Component> component;
-    int width;
-    int height;
-    
-    RectangleInfo(std::unique_ptr<juce::Component> comp, int w, int h)
-        : component(std::move(comp)), width(w), height(h) {}
-};
-
-/** @brief Panneau scrollable horizontal pour Zone4, gère une collection de panneaux d'accords. */
+/**
+ * @brief Bande scrollable horizontale virtualisée pour Zone4.
+ *
+ * La largeur couvre tous les éléments, mais seuls ceux visibles dans le Viewport parent (plus un
+ * débord de OVERSCAN) ont un composant. Les composants sortis de la vue retournent dans un pool
+ * et sont réutilisés au défilement ; un élément qui reste visible garde son composant (clé stable).
+ */
 class Zone4ScrollablePanel : public juce::Component
 {
 public:
     Zone4ScrollablePanel();
-    
+
     void paint(juce::Graphics& g) override;
     void resized() override;
-    
-    void addRectangle(std::unique_ptr<juce::Component> component);
-    void addRectangle(std::unique_ptr<juce::Component> component, int width, int height);
-    void clearAllRectangles();
-    int getNumRectangles() const;
-    
+    void moved() override;
+
+    /** @brief Crée un composant vierge (pool vide). */
+    std::function<std::unique_ptr<juce::Component>()> createItem;
+
+    /** @brief Branche un composant sur l'élément index (appelé à la matérialisation et après setItems). */
+    std::function<void(juce::Component&, int)> bindItem;
+
+    /** @brief Remplace les éléments, identifiés par leur clé ; les éléments visibles sont rebranchés. */
+    void setItems(std::vector<int> newItemKeys);
+    void clearAllItems();
+    int getNumItems() const { return static_cast<int>(itemKeys.size()); }
+    int getNumMaterialisedItems() const { return static_cast<int>(visibleItems.size()); }
+
     void updateContentSize();
-    
+
 private:
-    std::vector<RectangleInfo> rectangles;
-    
+    struct VisibleItem
+    {
+        int key;
+        int index;
+        std::unique_ptr<juce::Component> component;
+    };
+
+    std::vector<int> itemKeys;
+    std::vector<VisibleItem> visibleItems;
+    std::vector<std::unique_ptr<juce::Component>> pool;
+    juce::Range<int> materialisedRange;
+
     static constexpr int MIN_CONTENT_WIDTH = 50;
     static constexpr int SCROLLBAR_SPACE = 10;
-    
-    void layoutRectangles();
+
+    /** @brief Matérialise la plage visible ; rebindAll rebranche aussi les composants conservés. */
+    void updateVisibleItems(bool rebindAll);
+    juce::Range<int> getVisibleIndexRange() const;
     int calculateRequiredWidth() const;
     int calculateChordWidth(int height) const;
-    
+    int getRectangleHeight() const { return getHeight() - SCROLLBAR_SPACE; }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Zone4ScrollablePanel)
 };
@@ -17,6 +17,9 @@ SectionEditor::SectionEditor()
 
 SectionEditor::~SectionEditor()
 {
+    if (appController != nullptr)
+        appController->removeEditBatchListener(this);
+    
     if (currentSectionState.isValid())
         currentSectionState.removeListener(this);
     
@@ -110,7 +113,17 @@ void SectionEditor::parentHierarchyChanged()
 void SectionEditor::findAppController()
 {
     auto* pluginEditor = findParentComponentOfClass<AudioPluginAudioProcessorEditor>();
-    appController = (pluginEditor != nullptr) ? &pluginEditor->getAppController() : nullptr;
+    auto* found = (pluginEditor != nullptr) ? &pluginEditor->getAppController() : nullptr;
+    if (found == appController)
+        return;
+    
+    if (appController != nullptr)
+        appController->removeEditBatchListener(this);
+    
+    appController = found;
+    
+    if (appController != nullptr)
+        appController->addEditBatchListener(this);
 }
 
 void SectionEditor::updateContent()
@@ -297,13 +310,45 @@ void SectionEditor::syncZonesFromModel()
     keyZone.setKey(static_cast<int>(note));
     modeZone.setSelectedMode(isMajor ? Diatony::Mode::Major : Diatony::Mode::Minor);
     
-    auto progression = section.getProgression();
+    syncChordsFromModel();
+}
+
+void SectionEditor::syncChordsFromModel()
+{
+    if (!currentSectionState.isValid())
+        return;
+    
+    auto progression = Section(currentSectionState).getProgression();
     std::vector<juce::ValueTree> chords;
+    chords.reserve(progression.size());
     for (size_t i = 0; i < progression.size(); ++i)
         chords.push_back(progression.getChord(i).getState());
     zone4Component.syncWithProgression(chords);
 }
 
+void SectionEditor::requestSync(bool chordsOnly)
+{
+    if (appController != nullptr && appController->isInEditBatch())
+    {
+        syncPending = true;
+        return;
+    }
+    
+    if (chordsOnly)
+        syncChordsFromModel();
+    else
+        syncZonesFromModel();
+}
+
+void SectionEditor::pieceEditBatchEnded(Piece&)
+{
+    if (!syncPending)
+        return;
+    
+    syncPending = false;
+    syncZonesFromModel();
+}
+
 void SectionEditor::valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged,
                                              const juce::Identifier& property)
 {
@@ -311,7 +356,7 @@ void SectionEditor::valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyH
     
     if (treeWhosePropertyHasChanged == currentSectionState)
     {
-        syncZonesFromModel();
+        requestSync(false);
         return;
     }
     
@@ -320,12 +365,7 @@ void SectionEditor::valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyH
         auto parent = treeWhosePropertyHasChanged.getParent();
         if (currentProgressionState.isValid() && parent == currentProgressionState)
         {
-            Section section(currentSectionState);
-            auto progression = section.getProgression();
-            std::vector<juce::ValueTree> chords;
-            for (size_t i = 0; i < progression.size(); ++i)
-                chords.push_back(progression.getChord(i).getState());
-            zone4Component.syncWithProgression(chords);
+            requestSync(true);
             return;
         }
     }
@@ -340,12 +380,7 @@ void SectionEditor::valueTreeChildAdded(juce::ValueTree& parentTree, juce::Value
     if (parentTree == currentProgressionState && 
         childWhichHasBeenAdded.hasType(ModelIdentifiers::CHORD))
     {
-        Section section(currentSectionState);
-        auto progression = section.getProgression();
-        std::vector<juce::ValueTree> chords;
-        for (size_t i = 0; i < progression.size(); ++i)
-            chords.push_back(progression.getChord(i).getState());
-        zone4Component.syncWithProgression(chords);
+        requestSync(true);
     }
 }
 
@@ -356,11 +391,6 @@ void SectionEditor::valueTreeChildRemoved(juce::ValueTree& parentTree, juce::Val
     if (parentTree == currentProgressionState && 
         childWhichHasBeenRemoved.hasType(ModelIdentifiers::CHORD))
     {
-        Section section(currentSectionState);
-        auto progression = section.getProgression();
-        std::vector<juce::ValueTree> chords;
-        for (size_t i = 0; i < progression.size(); ++i)
-            chords.push_back(progression.getChord(i).getState());
-        zone4Component.syncWithProgression(chords);
+        requestSync(true);
     }
 }
@@ -12,7 +12,7 @@
 #include "controller/AppController.h"
 
 /** @brief Éditeur de section affichant KeyZone, ModeZone et Zone4 (accords). */
-class SectionEditor : public juce::Component, public juce::ValueTree::Listener
+class SectionEditor : public juce::Component, public juce::ValueTree::Listener, private Piece::Listener
 {
 public:
     SectionEditor();
@@ -42,6 +42,7 @@ private:
     juce::Label sectionNameLabel;               // Label pour le titre de la progression
     
     AppController* appController = nullptr;
+    bool syncPending = false;                   // Changements reçus pendant un lot d'éditions
     juce::SharedResourcePointer<FontManager> fontManager;
     
     // Composants des zones de paramètres (style BaseZone)
@@ -72,6 +73,11 @@ private:
 
     void bindZonesToModel();
     void syncZonesFromModel();
+    void syncChordsFromModel();
+    
+    /** @brief Resynchronise maintenant, ou une seule fois en fin de lot d'éditions. */
+    void requestSync(bool chordsOnly);
+    void pieceEditBatchEnded(Piece&) override;
 
     // ValueTree::Listener
     void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged,
@@ -16,6 +16,9 @@ OverviewContentArea::OverviewContentArea()
 
 OverviewContentArea::~OverviewContentArea()
 {
+    if (appController != nullptr)
+        appController->removeEditBatchListener(this);
+    
     if (modelState.isValid())
         modelState.removeListener(this);
     
@@ -33,9 +36,13 @@ void OverviewContentArea::findAppController()
 {
     auto* pluginEditor = findParentComponentOfClass<AudioPluginAudioProcessorEditor>();
     
+    if (appController != nullptr)
+        appController->removeEditBatchListener(this);
+    
     if (pluginEditor != nullptr)
     {
         appController = &pluginEditor->getAppController();
+        appController->addEditBatchListener(this);
         setModelState(appController->getState());
         
         selectionState = appController->getSelectionState();
@@ -83,7 +90,7 @@ void OverviewContentArea::refreshFromModel()
         }
         else if (child.hasType(ModelIdentifiers::MODULATION))
         {
-            createPanelForModulation(child);
+            createPanelForModulation(child, static_cast<int>(modulationPanels.size()));
         }
     }
     
@@ -92,43 +99,177 @@ void OverviewContentArea::refreshFromModel()
     updateSelectionHighlight();
 }
 
+bool OverviewContentArea::deferDuringEditBatch()
+{
+    if (appController == nullptr || !appController->isInEditBatch())
+        return false;
+    
+    refreshPending = true;
+    return true;
+}
+
+void OverviewContentArea::pieceEditBatchEnded(Piece&)
+{
+    if (!refreshPending)
+        return;
+    
+    refreshPending = false;
+    refreshFromModel();
+}
+
 void OverviewContentArea::valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged,
                                                   const juce::Identifier& property)
 {
-    if (property == ModelIdentifiers::name && treeWhosePropertyHasChanged.hasType(ModelIdentifiers::SECTION))
-        refreshFromModel();
-    else if (property == ContextIdentifiers::selectedElementId && treeWhosePropertyHasChanged == selectionState)
+    // Le nom de section n'est pas affiché (libellés "Pn") : rien à reconstruire sur un renommage
+    if (property == ContextIdentifiers::selectedElementId && treeWhosePropertyHasChanged == selectionState)
         updateSelectionHighlight();
 }
 
-void OverviewContentArea::valueTreeChildAdded(juce::ValueTree&, juce::ValueTree& childWhichHasBeenAdded)
+void OverviewContentArea::valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenAdded)
 {
+    if (parentTree != modelState || deferDuringEditBatch())
+        return;
+    
     if (childWhichHasBeenAdded.hasType(ModelIdentifiers::SECTION))
         handleSectionAdded(childWhichHasBeenAdded);
     else if (childWhichHasBeenAdded.hasType(ModelIdentifiers::MODULATION))
-        refreshFromModel();
+        handleModulationAdded(childWhichHasBeenAdded);
 }
 
-void OverviewContentArea::valueTreeChildRemoved(juce::ValueTree&, 
+void OverviewContentArea::valueTreeChildRemoved(juce::ValueTree& parentTree, 
                                                juce::ValueTree& childWhichHasBeenRemoved, 
                                                int)
 {
+    if (parentTree != modelState || deferDuringEditBatch())
+        return;
+    
     if (childWhichHasBeenRemoved.hasType(ModelIdentifiers::SECTION))
-        handleSectionRemoved();
+        handleSectionRemoved(childWhichHasBeenRemoved);
     else if (childWhichHasBeenRemoved.hasType(ModelIdentifiers::MODULATION))
-        refreshFromModel();
+        handleModulationRemoved(childWhichHasBeenRemoved);
 }
 
-void OverviewContentArea::valueTreeChildOrderChanged(juce::ValueTree&, int, int)
+void OverviewContentArea::valueTreeChildOrderChanged(juce::ValueTree& parentTree, int, int newIndex)
 {
-    refreshFromModel();
+    if (parentTree != modelState || deferDuringEditBatch())
+        return;
+    
+    auto moved = modelState.getChild(newIndex);
+    auto& panels = moved.hasType(ModelIdentifiers::SECTION) ? sectionPanels : modulationPanels;
+    const int from = findPanelIndex(panels, moved.getProperty(ModelIdentifiers::id, -1));
+    const int to = getRankInModel(moved);
+    
+    if (from < 0 || to < 0 || to >= static_cast<int>(panels.size()))
+    {
+        refreshFromModel();
+        return;
+    }
+    
+    auto first = panels.begin();
+    if (from < to)
+        std::rotate(first + from, first + from + 1, first + to + 1);
+    else if (from > to)
+        std::rotate(first + to, first + from, first + from + 1);
+    
+    const int lowestRank = juce::jmin(from, to);
+    if (&panels == &sectionPanels)
+        relabelSectionsFrom(lowestRank);
+    layoutPanelsFrom(lowestRank, true);
 }
 
 void OverviewContentArea::valueTreeParentChanged(juce::ValueTree&) {}
 
-void OverviewContentArea::handleSectionAdded(const juce::ValueTree&) { refreshFromModel(); }
+void OverviewContentArea::handleSectionAdded(const juce::ValueTree& sectionNode)
+{
+    const int rank = juce::jlimit(0, static_cast<int>(sectionPanels.size()), getRankInModel(sectionNode));
+    createPanelForSection(sectionNode, rank, false);
+    relabelSectionsFrom(rank + 1);
+    layoutPanelsFrom(rank, true);
+    updateVisibility();
+}
+
+void OverviewContentArea::handleSectionRemoved(const juce::ValueTree& sectionNode)
+{
+    const int rank = findPanelIndex(sectionPanels, sectionNode.getProperty(ModelIdentifiers::id, -1));
+    if (rank < 0)
+        return;
+    
+    sectionPanels.erase(sectionPanels.begin() + rank);
+    relabelSectionsFrom(rank);
+    layoutPanelsFrom(rank, true);
+    updateVisibility();
+}
+
+void OverviewContentArea::handleModulationAdded(const juce::ValueTree& modulationNode)
+{
+    const int rank = juce::jlimit(0, static_cast<int>(modulationPanels.size()), getRankInModel(modulationNode));
+    createPanelForModulation(modulationNode, rank);
+    layoutPanelsFrom(rank, true);
+}
+
+void OverviewContentArea::handleModulationRemoved(const juce::ValueTree& modulationNode)
+{
+    const int rank = findPanelIndex(modulationPanels, modulationNode.getProperty(ModelIdentifiers::id, -1));
+    if (rank < 0)
+        return;
+    
+    modulationPanels.erase(modulationPanels.begin() + rank);
+    layoutPanelsFrom(rank, true);
+}
+
+int OverviewContentArea::getRankInModel(const juce::ValueTree& node) const
+{
+    const int id = node.getProperty(ModelIdentifiers::id, -1);
+    
+    // Rang en O(1) via l'index de la pièce quand le contrôleur est connu
+    if (appController != nullptr && modelState == appController->getState())
+    {
+        auto& piece = appController->getPiece();
+        return node.hasType(ModelIdentifiers::SECTION) ? piece.getSectionIndexById(id)
+                                                       : piece.getModulationIndexById(id);
+    }
+    
+    int rank = 0;
+    for (int i = 0; i < modelState.getNumChildren(); ++i)
+    {
+        auto child = modelState.getChild(i);
+        if (child == node)
+            return rank;
+        if (child.hasType(node.getType()))
+            ++rank;
+    }
+    return -1;
+}
+
+int OverviewContentArea::findPanelIndex(const std::vector<std::unique_ptr<ButtonColoredPanel>>& panels, int elementId)
+{
+    // Depuis la fin : les retraits (removeAllChildren, removeLastSection) portent sur les derniers
+    for (int i = static_cast<int>(panels.size()) - 1; i >= 0; --i)
+        if (static_cast<int>(panels[static_cast<size_t>(i)]->getUserData()) == elementId)
+            return i;
+    return -1;
+}
+
+void OverviewContentArea::relabelSectionsFrom(int sectionRank)
+{
+    for (size_t i = static_cast<size_t>(juce::jmax(0, sectionRank)); i < sectionPanels.size(); ++i)
+        sectionPanels[i]->setDisplayText("P" + juce::String(static_cast<int>(i) + 1));
+}
 
-void OverviewContentArea::handleSectionRemoved() { refreshFromModel(); }
+void OverviewContentArea::applySelection(ButtonColoredPanel& panel) const
+{
+    if (!selectionState.isValid())
+        return;
+    
+    juce::String selectedElementId = selectionState.getProperty(ContextIdentifiers::selectedElementId, "");
+    juce::String selectionType = selectionState.getProperty(ContextIdentifiers::selectionType, "None");
+    
+    const bool isSection = panel.getContentType() == PanelContentType::Section;
+    const juce::String prefix = isSection ? "Section_" : "Modulation_";
+    const bool typeMatches = selectionType == (isSection ? "Section" : "Modulation");
+    
+    panel.setSelected(typeMatches && prefix + juce::String(static_cast<int>(panel.getUserData())) == selectedElementId);
+}
 
 void OverviewContentArea::createPanelForSection(const juce::ValueTree& sectionNode, int sectionIndex, bool autoSelect)
 {
@@ -156,14 +297,16 @@ void OverviewContentArea::createPanelForSection(const juce::ValueTree& sectionNo
         }
     };
     
+    applySelection(*newPanel);
     overlayContainer->addAndMakeVisible(newPanel.get());
-    sectionPanels.push_back(std::move(newPanel));
+    sectionPanels.insert(sectionPanels.begin() + juce::jlimit(0, static_cast<int>(sectionPanels.size()), sectionIndex),
+                         std::move(newPanel));
     
     if (autoSelect && appController && sectionIndex >= 0)
         appController->selectSection(sectionIndex);
 }
 
-void OverviewContentArea::createPanelForModulation(const juce::ValueTree& modulationNode)
+void OverviewContentArea::createPanelForModulation(const juce::ValueTree& modulationNode, int modulationIndex)
 {
     int modulationId = modulationNode.getProperty(ModelIdentifiers::id, -1);
     if (modulationId < 0)
@@ -181,41 +324,49 @@ void OverviewContentArea::createPanelForModulation(const juce::ValueTree& modula
         this->onPanelClicked(newPanelPtr);
     };
     
+    applySelection(*newPanel);
     overlayContainer->addAndMakeVisible(newPanel.get());
-    modulationPanels.push_back(std::move(newPanel));
+    modulationPanels.insert(modulationPanels.begin() + juce::jlimit(0, static_cast<int>(modulationPanels.size()), modulationIndex),
+                            std::move(newPanel));
 }
 
 void OverviewContentArea::layoutPanels()
+{
+    layoutPanelsFrom(0, false);
+}
+
+void OverviewContentArea::layoutPanelsFrom(int firstRank, bool animate)
 {
     if (!overlayContainer)
         return;
     
-    int x = 0;
-    int sectionIdx = 0;
-    int modulationIdx = 0;
+    auto& animator = juce::Desktop::getInstance().getAnimator();
     
-    for (int i = 0; i < modelState.getNumChildren(); ++i)
+    // Les panels déjà placés qui changent de position glissent ; les nouveaux apparaissent en place
+    auto place = [&](ButtonColoredPanel& panel, juce::Rectangle<int> bounds)
     {
-        auto child = modelState.getChild(i);
+        if (panel.getBounds() == bounds)
+            return;
         
-        if (child.hasType(ModelIdentifiers::SECTION) && sectionIdx < (int)sectionPanels.size())
-        {
-            sectionPanels[sectionIdx]->setBounds(x, 10, SECTION_WIDTH, SECTION_HEIGHT);
-            x += SECTION_WIDTH;
-            sectionIdx++;
-        }
-        else if (child.hasType(ModelIdentifiers::MODULATION) && modulationIdx < (int)modulationPanels.size())
-        {
-            // Modulation superposée à la jonction des sections
-            int modX = x - MODULATION_WIDTH / 2;
-            int modY = (PREFERRED_HEIGHT - MODULATION_HEIGHT) / 2;
-            modulationPanels[modulationIdx]->setBounds(modX, modY, MODULATION_WIDTH, MODULATION_HEIGHT);
-            modulationPanels[modulationIdx]->toFront(false);
-            modulationIdx++;
-        }
+        if (animate && !panel.getBounds().isEmpty())
+            animator.animateComponent(&panel, bounds, panel.getAlpha(), ANIMATION_MS, false, 1.0, 1.0);
+        else
+            panel.setBounds(bounds);
+    };
+    
+    // Sections jointives ; la modulation k est superposée à la jonction des sections k et k+1
+    for (size_t i = static_cast<size_t>(juce::jmax(0, firstRank)); i < sectionPanels.size(); ++i)
+        place(*sectionPanels[i], { static_cast<int>(i) * SECTION_WIDTH, 10, SECTION_WIDTH, SECTION_HEIGHT });
+    
+    const int modY = (PREFERRED_HEIGHT - MODULATION_HEIGHT) / 2;
+    for (size_t i = static_cast<size_t>(juce::jmax(0, firstRank - 1)); i < modulationPanels.size(); ++i)
+    {
+        const int modX = (static_cast<int>(i) + 1) * SECTION_WIDTH - MODULATION_WIDTH / 2;
+        place(*modulationPanels[i], { modX, modY, MODULATION_WIDTH, MODULATION_HEIGHT });
+        modulationPanels[i]->toFront(false);
     }
     
-    int totalWidth = juce::jmax(100, x);
+    int totalWidth = juce::jmax(100, static_cast<int>(sectionPanels.size()) * SECTION_WIDTH);
     overlayContainer->setSize(totalWidth, PREFERRED_HEIGHT);
 }
 
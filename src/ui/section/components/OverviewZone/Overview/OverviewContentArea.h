@@ -5,6 +5,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "ui/extra/Button/ButtonColoredPanel.h"
 #include "controller/ContextIdentifiers.h"
+#include "model/Piece.h"
 
 class ButtonColoredPanel;
 class AppController;
@@ -14,8 +15,9 @@ class AudioPluginAudioProcessorEditor;
  * @brief Zone de contenu d'aperçu gérant l'affichage des progressions.
  *
  * Architecture réactive : écoute les changements du modèle via ValueTree::Listener.
+ * Pendant un lot d'éditions (chargement...), une seule reconstruction en fin de lot.
  */
-class OverviewContentArea : public juce::Component, public juce::ValueTree::Listener
+class OverviewContentArea : public juce::Component, public juce::ValueTree::Listener, private Piece::Listener
 {
 public:
     OverviewContentArea();
@@ -69,8 +71,10 @@ private:
     static constexpr int SECTION_HEIGHT = 25;
     static constexpr int MODULATION_WIDTH = 24;
     static constexpr int MODULATION_HEIGHT = 35;
+    static constexpr int ANIMATION_MS = 150;
     
     int nextPanelId = 1;
+    bool refreshPending = false;            // Changements reçus pendant un lot d'éditions
     
     void setupViewport();
     void setupEmptyLabel();
@@ -79,13 +83,27 @@ private:
     void findAppController();
     
     // Méthodes pour l'architecture réactive
-    void refreshFromModel();   // Met à jour l'UI depuis le modèle
+    void refreshFromModel();   // Reconstruction complète (connexion au modèle, fin de lot d'éditions)
+    
+    /** @brief true si la modification fait partie d'un lot : reconstruction différée à pieceEditBatchEnded. */
+    bool deferDuringEditBatch();
+    void pieceEditBatchEnded(Piece&) override;
+    
+    // Mises à jour incrémentales : un panel créé/détruit, libellés et positions des suivants seulement
     void handleSectionAdded(const juce::ValueTree& sectionNode);
-    void handleSectionRemoved();
-    void createPanelForSection(const juce::ValueTree& sectionNode, int sectionIndex, bool autoSelect);  // Crée un panel visuel pour une section
-    void createPanelForModulation(const juce::ValueTree& modulationNode);  // Crée un panel visuel pour une modulation
+    void handleSectionRemoved(const juce::ValueTree& sectionNode);
+    void handleModulationAdded(const juce::ValueTree& modulationNode);
+    void handleModulationRemoved(const juce::ValueTree& modulationNode);
+    int getRankInModel(const juce::ValueTree& node) const;
+    static int findPanelIndex(const std::vector<std::unique_ptr<ButtonColoredPanel>>& panels, int elementId);
+    void relabelSectionsFrom(int sectionRank);  // Numérotation "Pn" à partir d'un rang
+    void applySelection(ButtonColoredPanel& panel) const;
+    
+    void createPanelForSection(const juce::ValueTree& sectionNode, int sectionIndex, bool autoSelect);  // Crée un panel visuel pour une section, inséré au rang donné
+    void createPanelForModulation(const juce::ValueTree& modulationNode, int modulationIndex);  // Crée un panel visuel pour une modulation
     void updateSelectionHighlight(); // Met à jour l'aspect visuel des panels selon la sélection centrale
     void layoutPanels();  // Positionne les panels avec modulations superposées aux jonctions
+    void layoutPanelsFrom(int firstSectionRank, bool animate);  // Seuls les panels à partir de ce rang bougent
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OverviewContentArea)
 };
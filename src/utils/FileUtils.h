@@ -29,6 +29,16 @@ namespace FileUtils {
         return midiFolder;
     }
     
+    /** @brief Fichier du cache de solutions persistant, à côté des MIDI générés. */
+    inline juce::File getSolutionCacheFile() {
+        return getMidiSolutionsFolder().getChildFile("diatony_solution_cache.bin");
+    }
+    
+    /** @brief Index persistant de l'historique (métadonnées des .diatony du dossier des solutions). */
+    inline juce::File getHistoryCatalogueFile() {
+        return getMidiSolutionsFolder().getChildFile("diatony_history_catalogue.bin");
+    }
+    
     /** @brief Ouvre le dossier des solutions MIDI dans l'explorateur natif. */
     inline void openMidiSolutionsFolder() {
         getMidiSolutionsFolder().startAsProcess();
@@ -0,0 +1,84 @@
+#include "IconCache.h"
+
+IconCache::DrawablePtr IconCache::getDrawable(const char* svgData, size_t svgDataSize)
+{
+    const juce::ScopedLock sl(lock);
+    return parseLocked(svgData, svgDataSize);
+}
+
+IconCache::DrawablePtr IconCache::getTintedDrawable(const char* svgData, size_t svgDataSize, juce::Colour tint)
+{
+    const juce::ScopedLock sl(lock);
+    return tintLocked(svgData, svgDataSize, tint);
+}
+
+juce::Image IconCache::getImage(const char* svgData, size_t svgDataSize, juce::Colour tint,
+                                int width, int height, float scaleFactor)
+{
+    const juce::ScopedLock sl(lock);
+
+    // Facteur d'échelle quantifié au centième : 1.0, 1.25, 2.0… partagent leurs entrées
+    const int scaleKey = juce::roundToInt(scaleFactor * 100.0f);
+    const ImageKey key { svgData, tint.getARGB(), width, height, scaleKey };
+
+    auto it = images.find(key);
+    if (it != images.end())
+        return it->second;
+
+    auto drawable = tintLocked(svgData, svgDataSize, tint);
+    const int pixelWidth = juce::jmax(1, juce::roundToInt(static_cast<float>(width) * scaleFactor));
+    const int pixelHeight = juce::jmax(1, juce::roundToInt(static_cast<float>(height) * scaleFactor));
+
+    juce::Image image(juce::Image::ARGB, pixelWidth, pixelHeight, true);
+    if (drawable != nullptr)
+    {
+        juce::Graphics g(image);
+        drawable->drawWithin(g, image.getBounds().toFloat(), juce::RectanglePlacement::centred, 1.0f);
+    }
+
+    if (images.size() >= MAX_VARIANTS)
+        images.clear();
+
+    images.emplace(key, image);
+    return image;
+}
+
+IconCache::DrawablePtr IconCache::parseLocked(const char* svgData, size_t svgDataSize)
+{
+    auto it = parsed.find(svgData);
+    if (it != parsed.end())
+        return it->second;
+
+    DrawablePtr drawable;
+    auto svgXml = juce::XmlDocument::parse(juce::String::fromUTF8(svgData, static_cast<int>(svgDataSize)));
+    if (svgXml != nullptr)
+        drawable = juce::Drawable::createFromSVG(*svgXml);
+
+    // Un SVG illisible est aussi mémorisé : pas de nouvelle analyse à chaque demande
+    parsed.emplace(svgData, drawable);
+    return drawable;
+}
+
+IconCache::DrawablePtr IconCache::tintLocked(const char* svgData, size_t svgDataSize, juce::Colour tint)
+{
+    const TintKey key { svgData, tint.getARGB() };
+
+    auto it = tinted.find(key);
+    if (it != tinted.end())
+        return it->second;
+
+    auto original = parseLocked(svgData, svgDataSize);
+    DrawablePtr result;
+    if (original != nullptr)
+    {
+        std::shared_ptr<juce::Drawable> copy = original->createCopy();
+        copy->replaceColour(juce::Colours::black, tint);
+        result = std::move(copy);
+    }
+
+    if (tinted.size() >= MAX_VARIANTS)
+        tinted.clear();
+
+    tinted.emplace(key, result);
+    return result;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <map>
+#include <memory>
+#include <tuple>
+
+/**
+ * @brief Cache d'icônes SVG partagé (à utiliser via SharedResourcePointer<IconCache>).
+ *
+ * Chaque SVG n'est analysé qu'une fois ; les variantes teintées (noir remplacé par une couleur)
+ * et les rasterisations par taille/facteur d'échelle sont elles aussi mémorisées.
+ * Les Drawables rendus sont partagés et immuables : les appelants ne font que les dessiner.
+ * Accès protégé par verrou, utilisable depuis n'importe quel thread.
+ */
+class IconCache
+{
+public:
+    using DrawablePtr = std::shared_ptr<const juce::Drawable>;
+
+    IconCache() = default;
+    ~IconCache() = default;
+
+    /** @brief SVG tel quel (nullptr si illisible). Clé : adresse des données binaires. */
+    DrawablePtr getDrawable(const char* svgData, size_t svgDataSize);
+
+    /** @brief SVG dont le noir est remplacé par tint. */
+    DrawablePtr getTintedDrawable(const char* svgData, size_t svgDataSize, juce::Colour tint);
+
+    /** @brief Rasterisation teintée de taille logique width × height au facteur d'échelle donné. */
+    juce::Image getImage(const char* svgData, size_t svgDataSize, juce::Colour tint,
+                         int width, int height, float scaleFactor);
+
+private:
+    using TintKey = std::pair<const char*, juce::uint32>;
+    using ImageKey = std::tuple<const char*, juce::uint32, int, int, int>;
+
+    static constexpr size_t MAX_VARIANTS = 256;  // Teintes/rasterisations : purge au-delà
+
+    juce::CriticalSection lock;
+    std::map<const char*, DrawablePtr> parsed;
+    std::map<TintKey, DrawablePtr> tinted;
+    std::map<ImageKey, juce::Image> images;
+
+    DrawablePtr parseLocked(const char* svgData, size_t svgDataSize);
+    DrawablePtr tintLocked(const char* svgData, size_t svgDataSize, juce::Colour tint);
+
+    JUCE_DECLARE_NON_COPYABLE(IconCache)
+};